@@ -0,0 +1,221 @@
+/*
+ * Compares how many evaluations each set of crossover and mutation operators
+ * needs to find a good architecture. The generations of the genetic
+ * algorithm (elites, selection, one crossover, mutations, random fill) are
+ * replayed with the analytic model standing in for ABC and VPR, so a run
+ * takes milliseconds and every operator set sees the same seeds.
+ *
+ * The score of an architecture is the fitness of its estimate against k6_N10
+ * with W = 80; unroutable ones fail. The target is the best score over the
+ * whole search space times (1 + gap). An evaluation is a genome scored for
+ * the first time in a run.
+ *
+ * Usage: operators_bench [runs] [gap] [max evaluations]
+ * Defaults to 50 runs per operator set, a gap of 0.01 and 5000 evaluations.
+ */
+#include "AnalyticModel.h"
+#include "Operators.h"
+#include "Population.h"
+#include "Selection.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Genome = Architecture::Genome;
+
+/* The defaults of main.cpp, except that crossover and mutation always
+ * happen so that the operators make a difference */
+const unsigned POPULATION = 20;
+const unsigned ELITES = 2;
+const unsigned NUM_SELECTION = 5;
+const float MUTATION_AMOUNT = 0.05f;
+
+const double INF = std::numeric_limits<double>::infinity();
+
+AnalyticModel::Estimate reference = AnalyticModel::estimate(6, 10, 80);
+
+double score(const Genome::Values& g) {
+    AnalyticModel::Estimate est = AnalyticModel::estimate(
+        g[Architecture::GENE_K], g[Architecture::GENE_N], g[Architecture::GENE_W]);
+    if (!est.routable) {
+        return INF;
+    }
+    return (est.area / reference.area + est.delay / reference.delay) / 2;
+}
+
+double best_score() {
+    double best = INF;
+    using K = Genome::GeneAt<Architecture::GENE_K>;
+    using N = Genome::GeneAt<Architecture::GENE_N>;
+    using W = Genome::GeneAt<Architecture::GENE_W>;
+    for (unsigned k = K::min; k <= K::max; k += K::step) {
+        for (unsigned n = N::min; n <= N::max; n += N::step) {
+            for (unsigned w = W::min; w <= W::max; w += W::step) {
+                best = std::min(best, score(Genome::Values{{k, n, w}}));
+            }
+        }
+    }
+    return best;
+}
+
+/**
+ * One run of the algorithm.
+ *
+ * \return the number of evaluations until the target was reached, or 0 if it
+ *         was not within max_evaluations.
+ */
+unsigned run(const Operators& operators, std::uint64_t seed, double target,
+             unsigned max_evaluations) {
+    Philox rng{seed};
+    Selection selection;
+    std::unordered_map<std::uint64_t, double> scores;
+
+    Population architectures, next_generation;
+    while (architectures.size() < POPULATION) {
+        architectures.add(Genome::random(rng));
+    }
+
+    std::vector<std::pair<double, unsigned>> keys;
+    std::vector<unsigned> order;
+    Population scratch;
+    while (true) {
+        // Evaluate
+        keys.clear();
+        for (unsigned i = 0; i < architectures.size(); i++) {
+            const Genome::Values g = architectures.genome(i);
+            auto found = scores.find(Genome::key(g));
+            double s;
+            if (found == scores.end()) {
+                s = score(g);
+                scores.emplace(Genome::key(g), s);
+                if (s <= target) {
+                    return scores.size();
+                }
+                if (scores.size() >= max_evaluations) {
+                    return 0;
+                }
+            }
+            else {
+                s = found->second;
+            }
+            // Failed ones are thrown away
+            if (s != INF) {
+                keys.emplace_back(s, i);
+            }
+        }
+
+        // Best first
+        std::sort(keys.begin(), keys.end());
+        order.clear();
+        for (const auto& key : keys) {
+            order.push_back(key.second);
+        }
+        scratch.gather(architectures, order);
+        architectures.swap(scratch);
+
+        next_generation.clear();
+        for (unsigned i = 0; i < ELITES && i < architectures.size(); i++) {
+            next_generation.add(architectures.genome(i));
+        }
+
+        std::vector<unsigned> selected = selection.select(architectures,
+                                                          NUM_SELECTION, rng);
+        if (selected.size() >= 2) {
+            unsigned a = selected[rng() % selected.size()];
+            unsigned b;
+            do {
+                b = selected[rng() % selected.size()];
+            } while (a == b);
+            auto children = Genome::crossover(architectures.genome(a),
+                                              architectures.genome(b),
+                                              rng, operators);
+            next_generation.add(children.first);
+            next_generation.add(children.second);
+        }
+        for (unsigned i : selected) {
+            Genome::Values mutant = architectures.genome(i);
+            Genome::mutate(mutant, MUTATION_AMOUNT, rng, operators);
+            next_generation.add(mutant);
+        }
+
+        next_generation.truncate(POPULATION);
+        while (next_generation.size() < POPULATION) {
+            next_generation.add(Genome::random(rng));
+        }
+        architectures.swap(next_generation);
+    }
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    unsigned runs = argc > 1 ? std::atoi(argv[1]) : 50;
+    double gap = argc > 2 ? std::atof(argv[2]) : 0.01;
+    unsigned max_evaluations = argc > 3 ? std::atoi(argv[3]) : 5000;
+    if (runs == 0 || gap < 0 || max_evaluations == 0) {
+        std::cerr << "Usage: " << argv[0]
+            << " [runs] [gap] [max evaluations]" << std::endl;
+        return 1;
+    }
+
+    const double target = best_score() * (1 + gap);
+    std::cout << runs << " runs per operator set, target score "
+        << target << ", at most " << max_evaluations << " evaluations"
+        << std::endl;
+    std::cout << std::setw(18) << std::left << "crossover"
+        << std::setw(20) << std::left << "mutation"
+        << std::setw(10) << std::right << "reached"
+        << std::setw(10) << std::right << "median"
+        << std::setw(10) << std::right << "mean" << std::endl;
+
+    const std::vector<std::pair<std::string, Operators::Crossover>> crossovers{
+        {"xor", Operators::Crossover::XOR},
+        {"blend", Operators::Crossover::BLEND},
+        {"sbx", Operators::Crossover::SBX}
+    };
+    const std::vector<std::pair<std::string, Operators::Mutation>> mutations{
+        {"gaussian", Operators::Mutation::GAUSSIAN},
+        {"polynomial", Operators::Mutation::POLYNOMIAL},
+        {"discrete-gaussian", Operators::Mutation::DISCRETE_GAUSSIAN}
+    };
+
+    for (const auto& c : crossovers) {
+        for (const auto& m : mutations) {
+            Operators operators{c.second, m.second};
+            // Runs that miss the target count as max_evaluations
+            std::vector<unsigned> evaluations;
+            unsigned reached = 0;
+            for (unsigned r = 0; r < runs; r++) {
+                unsigned n = run(operators, r + 1, target, max_evaluations);
+                reached += n != 0;
+                evaluations.push_back(n != 0 ? n : max_evaluations);
+            }
+            std::sort(evaluations.begin(), evaluations.end());
+            double mean = 0;
+            for (unsigned n : evaluations) {
+                mean += n;
+            }
+            mean /= runs;
+
+            std::cout << std::setw(18) << std::left << c.first
+                << std::setw(20) << std::left << m.first
+                << std::setw(10) << std::right << reached
+                << std::setw(10) << std::right << evaluations[runs / 2]
+                << std::setw(10) << std::right << std::fixed
+                << std::setprecision(1) << mean << std::endl;
+        }
+    }
+
+    return 0;
+}
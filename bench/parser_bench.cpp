@@ -0,0 +1,186 @@
+/*
+ * Replays VPR logs through the old regex based parser and through
+ * VprParser, and reports how long each takes per log.
+ *
+ * Usage: parser_bench [iterations] [log1.log log2.log ...]
+ * Without log files, the logs in bench/synthetic_logs are used. Those are
+ * generated in the layout of VPR 7 logs, with made-up numbers (the router
+ * iterations follow a fixed decay), so they only exercise the parsers on
+ * logs of a realistic size; timings that matter should come from real
+ * logs.
+ */
+#include "VprParser.h"
+
+#include <dirent.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define CRIT_PATH "Final critical path:"
+#define LOGIC_AREA "Total used logic block area:"
+#define ROUTE_AREA "Total routing area:"
+#define SCIENTIFIC_NOTATION "[-]?[0-9]+\\.[0-9]+([e][-+][0-9]+)"
+#define NUM_METRICS 3
+
+const double FAILED = -1;
+
+/* The parser as it was in Architecture::Benchmark::parse_results */
+std::pair<double, double> legacy_parse(FILE* res) {
+    double metrics[NUM_METRICS];
+    std::regex reg[NUM_METRICS] = {std::regex(LOGIC_AREA),
+        std::regex(ROUTE_AREA), std::regex(CRIT_PATH)};
+    std::stringstream ss;
+    std::string temp;
+    char line[256];
+    // Search stream until all metrics are found
+    for (size_t i = 0; i < NUM_METRICS;) {
+        // If you get to end of stream, output failure
+        if (!fgets(line, 256, res)) {
+            return std::pair<double, double>(FAILED, FAILED);
+        }
+        // If the stat we are looking for is found, parse the line
+        if (std::regex_search(line, reg[i])) {
+            ss << line;
+            while (ss >> temp) {
+                // If the number is represented in scientific notation,
+                // parse it to output a double
+                if (std::regex_match(temp, std::regex(SCIENTIFIC_NOTATION))) {
+                    metrics[i] = atof(temp.substr(0, temp.find('e') + 1).c_str());
+                    int exp = atoi(temp.substr(temp.find('e') + 1).c_str());
+                    while (exp != 0) {
+                        metrics[i] *= 10;
+                        exp--;
+                    }
+                    break;
+                }
+                else if (temp[0] >= '0' && temp[0] <= '9') {
+                    metrics[i] = atof(temp.c_str());
+                    break;
+                }
+            }
+            ss.str(std::string());
+            i++;
+        }
+    }
+    return std::pair<double, double>(metrics[0] + metrics[1], metrics[2]);
+}
+
+std::pair<double, double> new_parse(FILE* res) {
+    VprParser parser;
+    if (!parser.parse(res)) {
+        return std::pair<double, double>(FAILED, FAILED);
+    }
+    return std::pair<double, double>(parser.area(), parser.crit_path());
+}
+
+bool nearly_equal(double a, double b) {
+    return std::fabs(a - b) <= 1e-9 * std::max(std::fabs(a), std::fabs(b));
+}
+
+std::vector<std::string> default_logs() {
+    std::vector<std::string> logs;
+    DIR* dir = opendir(BENCH_LOG_DIR);
+    if (dir == nullptr) {
+        return logs;
+    }
+    while (struct dirent* ent = readdir(dir)) {
+        std::string name{ent->d_name};
+        if (name.size() > 4 && name.substr(name.size() - 4) == ".log") {
+            logs.push_back(std::string{BENCH_LOG_DIR} + '/' + name);
+        }
+    }
+    closedir(dir);
+    return logs;
+}
+
+/**
+ * Parses the log `iterations' times from memory.
+ *
+ * \return pair of the result of the last parse and the average time per
+ *         parse in microseconds.
+ */
+template<typename Parser>
+std::pair<std::pair<double, double>, double>
+replay(const std::string& log, unsigned iterations, Parser parse) {
+    std::pair<double, double> res;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < iterations; i++) {
+        FILE* in = fmemopen(const_cast<char*>(log.data()), log.size(), "r");
+        res = parse(in);
+        std::fclose(in);
+    }
+    auto end = std::chrono::steady_clock::now();
+    double us = std::chrono::duration<double, std::micro>(end - start).count();
+    return std::make_pair(res, us / iterations);
+}
+
+int main(int argc, char* argv[]) {
+    unsigned iterations = 20;
+    std::vector<std::string> files;
+    if (argc > 1) {
+        iterations = std::atoi(argv[1]);
+    }
+    for (int i = 2; i < argc; i++) {
+        files.push_back(argv[i]);
+    }
+    if (files.empty()) {
+        files = default_logs();
+    }
+    if (files.empty() || iterations == 0) {
+        std::cerr << "Usage: " << argv[0]
+            << " [iterations] [log1.log log2.log ...]" << std::endl;
+        return 1;
+    }
+
+    std::cout << std::setw(24) << std::left << "log"
+        << std::setw(10) << std::right << "KiB"
+        << std::setw(14) << "regex (us)"
+        << std::setw(14) << "scan (us)"
+        << std::setw(10) << "speedup"
+        << "  results" << std::endl;
+
+    double total_old = 0, total_new = 0;
+    for (const std::string& file : files) {
+        std::ifstream is(file);
+        std::stringstream buf;
+        buf << is.rdbuf();
+        std::string log = buf.str();
+
+        auto old_res = replay(log, iterations, legacy_parse);
+        auto new_res = replay(log, iterations, new_parse);
+        total_old += old_res.second;
+        total_new += new_res.second;
+
+        std::string name = file.substr(file.rfind('/') + 1);
+        // The old parser rebuilds exponents by repeated multiplication, so
+        // only compare up to rounding
+        bool same = nearly_equal(old_res.first.first, new_res.first.first)
+            && nearly_equal(old_res.first.second, new_res.first.second);
+        std::cout << std::setw(24) << std::left << name
+            << std::setw(10) << std::right << log.size() / 1024
+            << std::setw(14) << std::fixed << std::setprecision(1)
+            << old_res.second
+            << std::setw(14) << new_res.second
+            << std::setw(9) << std::setprecision(1)
+            << old_res.second / new_res.second << "x"
+            << "  " << (same ? "match" : "DIFFER") << std::endl;
+    }
+
+    std::cout << std::setw(24) << std::left << "total"
+        << std::setw(10) << ""
+        << std::setw(14) << std::right << total_old
+        << std::setw(14) << total_new
+        << std::setw(9) << total_old / total_new << "x" << std::endl;
+
+    return 0;
+}
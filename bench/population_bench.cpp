@@ -0,0 +1,237 @@
+/*
+ * Measures the per-generation bookkeeping of the genetic algorithm (throwing
+ * away failures, sorting, copying elites, selection, offspring and changing
+ * the generation) without running ABC or VPR, for the vector of
+ * Architecture the algorithm used to keep and for Population.
+ *
+ * Usage: population_bench [generations] [population] [benchmarks]
+ * Defaults to 10 generations of 10000 individuals with 50 benchmarks.
+ */
+#include "Population.h"
+#include "Selection.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+Philox gen{1};
+
+/* Stands in for ABC and VPR */
+void fake_results(Architecture::Benchmark& b, unsigned K, unsigned N, unsigned W) {
+    b.area = 1000.0 + K * N + (gen() % 100);
+    b.crit_path = 1.0 + W / 100.0 + (gen() % 100) / 1000.0;
+    b.is_populated = true;
+    b.status = Architecture::Benchmark::Status::SUCCESS;
+}
+
+void fake_results(Population::Result& r, unsigned K, unsigned N, unsigned W) {
+    r.area = 1000.0 + K * N + (gen() % 100);
+    r.crit_path = 1.0 + W / 100.0 + (gen() % 100) / 1000.0;
+    r.is_populated = true;
+    r.status = Architecture::Benchmark::Status::SUCCESS;
+}
+
+using clock_type = std::chrono::steady_clock;
+
+double ms_since(clock_type::time_point start) {
+    return std::chrono::duration<double, std::milli>(clock_type::now() - start).count();
+}
+
+/* What run_generation and change_generation did with std::vector<Architecture> */
+double legacy(unsigned generations, unsigned size,
+              const std::vector<Architecture::Benchmark>& benchmarks,
+              const Architecture& reference,
+              unsigned elites, unsigned num_selection) {
+    std::vector<Architecture> architectures;
+    for (unsigned i = 0; i < size; i++) {
+        architectures.push_back(Architecture::random(benchmarks));
+    }
+
+    double total = 0;
+    for (unsigned g = 0; g < generations; g++) {
+        for (Architecture& a : architectures) {
+            for (Architecture::Benchmark& b : a.bench) {
+                if (!b.is_populated) {
+                    fake_results(b, a.K, a.N, a.W);
+                }
+            }
+        }
+
+        auto start = clock_type::now();
+        std::vector<Architecture> next_generation;
+
+        auto new_end = std::remove_if(architectures.begin(), architectures.end(),
+                                      [](const Architecture& a) {
+                                      return !a.non_failed();
+                                      });
+        architectures.resize(std::distance(architectures.begin(), new_end));
+
+        std::sort(architectures.begin(), architectures.end(),
+                  [&reference](const Architecture& a, const Architecture& b) {
+                  return a.fitness(reference) < b.fitness(reference);
+                  });
+        std::copy(architectures.begin(), architectures.begin() + elites,
+                  std::back_inserter(next_generation));
+
+        std::vector<Architecture> selected;
+        for (unsigned i = 0; i < num_selection; i++) {
+            selected.push_back(architectures[gen() % architectures.size()]);
+        }
+        for (unsigned i = 0; i + 1 < selected.size(); i += 2) {
+            Architecture a = selected[i], b = selected[i + 1];
+            Architecture child1{benchmarks}, child2{benchmarks};
+            child1.K = a.K; child1.N = b.N; child1.W = a.W;
+            child2.K = b.K; child2.N = a.N; child2.W = b.W;
+            next_generation.push_back(std::move(child1));
+            next_generation.push_back(std::move(child2));
+        }
+        for (const Architecture& arch : selected) {
+            Architecture mutant{arch};
+            mutant.mutate(0.05f);
+            mutant.bench = benchmarks;
+            next_generation.push_back(std::move(mutant));
+        }
+
+        next_generation.resize(std::min<std::size_t>(next_generation.size(), size));
+        while (next_generation.size() < size) {
+            next_generation.push_back(Architecture::random(benchmarks));
+        }
+        architectures = next_generation;
+
+        total += ms_since(start);
+    }
+    return total / generations;
+}
+
+/* The same with Population and Selection */
+double current(unsigned generations, unsigned size,
+               const std::vector<Architecture::Benchmark>& benchmarks,
+               const Architecture& reference,
+               unsigned elites, unsigned num_selection) {
+    Population architectures{benchmarks};
+    Population next_generation{benchmarks};
+    Population scratch{benchmarks};
+    auto shared = std::make_shared<const Architecture>(reference);
+    for (Population* population : {&architectures, &next_generation, &scratch}) {
+        population->set_reference(shared);
+    }
+    for (unsigned i = 0; i < size; i++) {
+        Architecture a = Architecture::random();
+        architectures.add(a.K, a.N, a.W);
+    }
+    Selection selection{Selection::Scheme::ROULETTE};
+
+    double total = 0;
+    for (unsigned g = 0; g < generations; g++) {
+        for (unsigned i = 0; i < architectures.size(); i++) {
+            for (unsigned b = 0; b < architectures.num_benchmarks(); b++) {
+                Population::Result& r = architectures.result(i, b);
+                if (!r.is_populated) {
+                    fake_results(r, architectures.K(i), architectures.N(i),
+                                 architectures.W(i));
+                }
+            }
+        }
+
+        auto start = clock_type::now();
+        next_generation.clear();
+
+        architectures.remove_failed();
+
+        std::vector<std::pair<double, unsigned>> keys(architectures.size());
+        for (unsigned i = 0; i < keys.size(); i++) {
+            keys[i] = std::make_pair(architectures.fitness(i), i);
+        }
+        std::sort(keys.begin(), keys.end());
+        std::vector<unsigned> order(keys.size());
+        for (unsigned i = 0; i < keys.size(); i++) {
+            order[i] = keys[i].second;
+        }
+        scratch.gather(architectures, order);
+        architectures.swap(scratch);
+
+        for (unsigned i = 0; i < elites; i++) {
+            next_generation.add(architectures, i);
+        }
+
+        std::vector<unsigned> selected = selection.select(architectures,
+                                                          num_selection, gen);
+        for (unsigned i = 0; i + 1 < selected.size(); i += 2) {
+            unsigned a = selected[i], b = selected[i + 1];
+            next_generation.add(architectures.K(a), architectures.N(b),
+                                architectures.W(a));
+            next_generation.add(architectures.K(b), architectures.N(a),
+                                architectures.W(b));
+        }
+        for (unsigned i : selected) {
+            Architecture mutant;
+            mutant.K = architectures.K(i);
+            mutant.N = architectures.N(i);
+            mutant.W = architectures.W(i);
+            mutant.mutate(0.05f);
+            next_generation.add(mutant.K, mutant.N, mutant.W);
+        }
+
+        next_generation.truncate(size);
+        while (next_generation.size() < size) {
+            Architecture a = Architecture::random();
+            next_generation.add(a.K, a.N, a.W);
+        }
+        architectures.swap(next_generation);
+
+        total += ms_since(start);
+    }
+    return total / generations;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    unsigned generations = argc > 1 ? std::atoi(argv[1]) : 10;
+    unsigned size = argc > 2 ? std::atoi(argv[2]) : 10000;
+    unsigned num_benchmarks = argc > 3 ? std::atoi(argv[3]) : 50;
+    if (generations == 0 || size < 10 || num_benchmarks == 0) {
+        std::cerr << "Usage: " << argv[0]
+            << " [generations] [population] [benchmarks]" << std::endl;
+        return 1;
+    }
+
+    std::vector<Architecture::Benchmark> benchmarks;
+    for (unsigned b = 0; b < num_benchmarks; b++) {
+        benchmarks.emplace_back("/path/to/the/benchmarks/circuit_"
+                                + std::to_string(b) + ".blif");
+    }
+
+    // Every ratio is against these
+    Architecture reference{benchmarks};
+    for (Architecture::Benchmark& b : reference.bench) {
+        fake_results(b, 6, 10, 80);
+    }
+
+    // A fifth are carried over, a tenth are parents
+    unsigned elites = size / 5;
+    unsigned num_selection = size / 10;
+
+    double old_ms = legacy(generations, size, benchmarks, reference, elites, num_selection);
+    double new_ms = current(generations, size, benchmarks, reference, elites, num_selection);
+
+    std::cout << size << " individuals, " << num_benchmarks << " benchmarks, "
+        << generations << " generations" << std::endl;
+    std::cout << std::fixed << std::setprecision(2)
+        << std::setw(28) << std::left << "std::vector<Architecture>"
+        << std::setw(10) << std::right << old_ms << " ms/generation" << std::endl
+        << std::setw(28) << std::left << "Population"
+        << std::setw(10) << std::right << new_ms << " ms/generation" << std::endl
+        << std::setw(28) << std::left << "speedup"
+        << std::setw(9) << std::right << old_ms / new_ms << "x" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include "AnalyticModel.h"
+
+#include <cmath>
+#include <limits>
+#include <tuple>
+
+using Estimate = AnalyticModel::Estimate;
+
+const double AnalyticModel::TILE_AREA = 14813.392;
+const double AnalyticModel::FC_IN = 0.15;
+const double AnalyticModel::FC_OUT = 0.125;
+const unsigned AnalyticModel::SEGMENT_LENGTH = 4;
+const double AnalyticModel::MUX_TRANS_SIZE = 2.630740;
+const double AnalyticModel::IPIN_MUX_TRANS_SIZE = 1.222260;
+const double AnalyticModel::BUF_SIZE = 27.645901;
+const double AnalyticModel::T_LUT = 2.690e-10;
+const double AnalyticModel::T_CROSSBAR = 8.044e-11;
+const double AnalyticModel::T_IPIN_CBLOCK = 7.247e-11;
+const double AnalyticModel::T_SWITCH = 6.837e-11;
+
+Estimate AnalyticModel::estimate(unsigned K, unsigned N, unsigned W) {
+    Estimate est;
+    // Nothing sensible can be built from these (and VPR will fail on them)
+    if (K < 2 || N == 0 || W == 0) {
+        est.area = std::numeric_limits<double>::infinity();
+        est.delay = std::numeric_limits<double>::infinity();
+        est.routable = false;
+        return est;
+    }
+
+    const double I = Architecture::cluster_inputs(K, N);
+
+    // VPR charges a fixed tile area per used cluster, so the logic area only
+    // depends on how many clusters the logic needs
+    const double clusters = lut_count(K) / N;
+
+    // Switch block: one mux per wire start, 2 channels per tile. Each mux
+    // takes the Fs = 3 other wires plus its share of the cluster outputs.
+    const double wire_starts = 2.0 * W / SEGMENT_LENGTH;
+    const double sb_inputs = wire_starts * 3 + N * FC_OUT * W;
+    const double sb_area = sb_inputs * MUX_TRANS_SIZE + wire_starts * BUF_SIZE;
+    // Connection block: one Fc_in * W input mux per cluster input
+    const double cb_area = I * (FC_IN * W * IPIN_MUX_TRANS_SIZE + 1);
+
+    est.area = clusters * (TILE_AREA + sb_area + cb_area);
+
+    // Every level of logic goes through the crossbar and a LUT, and the
+    // connections that leave the cluster go through at least one hop
+    const double level = T_LUT + T_CROSSBAR
+        + external_fraction(N) * (T_IPIN_CBLOCK + T_SWITCH);
+    est.delay = logic_depth(K) * level;
+
+    est.routable = W >= channel_width_estimate(K, N);
+
+    return est;
+}
+
+unsigned AnalyticModel::channel_width_estimate(unsigned K, unsigned N) {
+    // Each input pin must see at least one track
+    unsigned fc_min = static_cast<unsigned>(std::ceil(1 / FC_IN));
+    // A cluster is reachable from the 4 channels around it; assume that at
+    // least half of its inputs are used
+    unsigned pin_min = (Architecture::cluster_inputs(K, N) + 7) / 8;
+    unsigned w = std::max(fc_min, pin_min);
+    return w % 2 == 0 ? w : w + 1;
+}
+
+std::pair<double, double> AnalyticModel::ratio_estimate(const Architecture& arch,
+                                                        const Architecture& ref,
+                                                        const float slack) {
+    Estimate a = estimate(arch.K, arch.N, arch.W);
+    // VPR may also route narrower channels than the model expects
+    if (std::isinf(a.area)
+        || arch.W < slack * channel_width_estimate(arch.K, arch.N)) {
+        const double inf = std::numeric_limits<double>::infinity();
+        return std::make_pair(inf, inf);
+    }
+    Estimate r = estimate(ref.K, ref.N, ref.W);
+
+    return std::make_pair(slack * a.area / r.area, slack * a.delay / r.delay);
+}
+
+double AnalyticModel::fitness_estimate(const Architecture& arch,
+                                       const Architecture& ref,
+                                       const float slack) {
+    double area, crit_path;
+    std::tie(area, crit_path) = ratio_estimate(arch, ref, slack);
+    return (crit_path + area) / 2;
+}
+
+/* Private methods */
+
+double AnalyticModel::lut_count(unsigned K) {
+    // Roughly follows the LUT counts reported when mapping the same circuits
+    // to different K: 4-LUTs need ~1.4x and 2-LUTs ~3.5x the 6-LUTs
+    return std::pow(5.0 / (K - 1), 0.8);
+}
+
+double AnalyticModel::logic_depth(unsigned K) {
+    return std::log2(6.0) / std::log2(static_cast<double>(K));
+}
+
+double AnalyticModel::external_fraction(unsigned N) {
+    // Rent's rule with p = 0.7: external connections grow as N^p while the
+    // logic grows as N
+    return std::pow(static_cast<double>(N), -0.3);
+}
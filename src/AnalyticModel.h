@@ -0,0 +1,98 @@
+#ifndef ANALYTIC_MODEL_H_
+#define ANALYTIC_MODEL_H_
+
+#include "Architecture.h"
+
+#include <utility>
+
+/**
+ * A cheap first-order model of the architectures generated from
+ * arch_template.xml. It is used to screen out candidates that are clearly
+ * dominated before any ABC/VPR process is launched.
+ *
+ * The constants mirror the values hard-coded in the template (tile area,
+ * Fc, segment length, switch and crossbar delays), and the cluster inputs
+ * are the same CLB_IN that make_arch_file() substitutes. The model only
+ * needs to be right in relative terms, since every estimate is divided by
+ * the estimate of the reference architecture.
+ */
+class AnalyticModel {
+public:
+    struct Estimate {
+        /* Area for a fixed amount of logic, in minimum transistor units */
+        double area;
+        /* Critical path for a fixed logic depth, in seconds */
+        double delay;
+        /* False if W is below channel_width_estimate */
+        bool routable;
+    };
+
+    /**
+     * Estimates the area and delay of an architecture.
+     * The absolute numbers have no meaning on their own (the amount of logic
+     * is unknown); only ratios between two estimates do.
+     */
+    static Estimate estimate(unsigned K, unsigned N, unsigned W);
+
+    /**
+     * An estimate of the channel width needed to connect the pins of a
+     * cluster to the routing, assuming that half of its inputs are used.
+     * It is not a bound: VPR may route narrower channels.
+     */
+    static unsigned channel_width_estimate(unsigned K, unsigned N);
+
+    /**
+     * Estimates of (vs_ref_area, vs_ref_crit_path) for an architecture that
+     * has not been run yet. They are not bounds; the slack is what keeps
+     * candidates VPR might do better on from being screened out.
+     *
+     * \param[in] arch the candidate architecture.
+     *
+     * \param[in] ref the architecture the reference results came from.
+     *
+     * \param[in] slack how much better than the model VPR is allowed to do,
+     *            i.e. the estimated ratios and the estimated channel width
+     *            are multiplied by this. Values closer to 0 make the
+     *            estimate more conservative.
+     *
+     * \return pair of area and critical path ratio estimates. Both are
+     *         infinite if W is below the channel width estimate times the
+     *         slack, or the architecture is degenerate.
+     */
+    static std::pair<double, double> ratio_estimate(const Architecture& arch,
+                                                    const Architecture& ref,
+                                                    const float slack);
+
+    /**
+     * Same as ratio_estimate but combined the same way as
+     * Architecture::fitness.
+     */
+    static double fitness_estimate(const Architecture& arch,
+                                   const Architecture& ref,
+                                   const float slack);
+
+private:
+    /* Values taken from arch_template.xml */
+    static const double TILE_AREA;
+    static const double FC_IN;
+    static const double FC_OUT;
+    static const unsigned SEGMENT_LENGTH;
+    static const double MUX_TRANS_SIZE;
+    static const double IPIN_MUX_TRANS_SIZE;
+    static const double BUF_SIZE;
+    static const double T_LUT;
+    static const double T_CROSSBAR;
+    static const double T_IPIN_CBLOCK;
+    static const double T_SWITCH;
+
+    /* Number of K-LUTs relative to the number of 6-LUTs for the same logic */
+    static double lut_count(unsigned K);
+
+    /* Number of LUT levels relative to the depth with 6-LUTs */
+    static double logic_depth(unsigned K);
+
+    /* Fraction of connections that leave a cluster of size N */
+    static double external_fraction(unsigned N);
+};
+
+#endif /* end of include guard */
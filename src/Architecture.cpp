@@ -1,25 +1,99 @@
 #include "Architecture.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <cerrno>
+
 using Benchmark = Architecture::Benchmark;
 
 const unsigned Architecture::UNSET = 0;
-const std::pair<unsigned, unsigned> Architecture::K_RANGE{2, 25};
-const std::pair<unsigned, unsigned> Architecture::N_RANGE{1, 50};
-const std::pair<unsigned, unsigned> Architecture::W_RANGE{1, 250};
-std::random_device Architecture::rd;
-std::mt19937_64 Architecture::gen{rd()};
-
-using u_dist_t = std::uniform_int_distribution<unsigned>;
-u_dist_t Architecture::k_rgen{K_RANGE.first, K_RANGE.second};
-u_dist_t Architecture::w_rgen{W_RANGE.first, W_RANGE.second};
-u_dist_t Architecture::n_rgen{N_RANGE.first, N_RANGE.second};
+const std::pair<unsigned, unsigned> Architecture::K_RANGE{
+    Architecture::Genome::GeneAt<Architecture::GENE_K>::min,
+    Architecture::Genome::GeneAt<Architecture::GENE_K>::max
+};
+const std::pair<unsigned, unsigned> Architecture::N_RANGE{
+    Architecture::Genome::GeneAt<Architecture::GENE_N>::min,
+    Architecture::Genome::GeneAt<Architecture::GENE_N>::max
+};
+const std::pair<unsigned, unsigned> Architecture::W_RANGE{
+    Architecture::Genome::GeneAt<Architecture::GENE_W>::min,
+    Architecture::Genome::GeneAt<Architecture::GENE_W>::max
+};
 
-std::vector<Benchmark> Architecture::reference_results = {};
 
 const double Benchmark::FAILED = -1;
 
+namespace {
+
+/**
+ * Creates an anonymous in-memory file with the given contents and seals it
+ * so that it cannot be changed anymore. The file is inherited by child
+ * processes.
+ *
+ * \return the file descriptor, or -1 if memfd is not available.
+ */
+int make_memfd(const char* name, const std::string& contents) {
+#if defined(SYS_memfd_create) && defined(MFD_ALLOW_SEALING)
+    int fd = syscall(SYS_memfd_create, name, MFD_ALLOW_SEALING);
+    if (fd == -1) {
+        return -1;
+    }
+
+    size_t written = 0;
+    while (written < contents.size()) {
+        ssize_t ret = write(fd, contents.data() + written,
+                            contents.size() - written);
+        if (ret == -1 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            close(fd);
+            return -1;
+        }
+        written += ret;
+    }
+
+    if (fcntl(fd, F_ADD_SEALS,
+              F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) == -1) {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+#else
+    (void)name;
+    (void)contents;
+    return -1;
+#endif
+}
+
+}
+
 /* Static methods */
 
+// Default constructor
+Benchmark::Stats::Stats()
+    : pack_time{0}
+    , place_time{0}
+    , route_time{0}
+    , route_iterations{0}
+    , wirelength{0}
+    , peak_rss{0}
+    , cpu_time{0}
+{ }
+
+Benchmark::Stats& Benchmark::Stats::operator+=(const Stats& other) {
+    pack_time += other.pack_time;
+    place_time += other.place_time;
+    route_time += other.route_time;
+    route_iterations += other.route_iterations;
+    wirelength += other.wirelength;
+    peak_rss = std::max(peak_rss, other.peak_rss);
+    cpu_time += other.cpu_time;
+    return *this;
+}
+
 /* Constructors, Destructor, and Assignment operators {{{ */
 // Default constructor
 Benchmark::Benchmark()
@@ -27,6 +101,8 @@ Benchmark::Benchmark()
     , area{FAILED}
     , benchmark{""}
     , is_populated{false}
+    , status{Status::NOT_RUN}
+    , stats{}
 { }
 
 // Copy constructor
@@ -35,6 +111,8 @@ Benchmark::Benchmark(const Benchmark& other)
     , area{other.area}
     , benchmark{other.benchmark}
     , is_populated{other.is_populated}
+    , status{other.status}
+    , stats{other.stats}
 { }
 
 // Move constructor
@@ -43,6 +121,8 @@ Benchmark::Benchmark(Benchmark&& other)
     , area{std::move(other.area)}
     , benchmark{std::move(other.benchmark)}
     , is_populated{std::move(other.is_populated)}
+    , status{std::move(other.status)}
+    , stats{std::move(other.stats)}
 { }
 
 // Filename constructor
@@ -51,6 +131,8 @@ Benchmark::Benchmark(const std::string& filename)
     , area{FAILED}
     , benchmark{filename}
     , is_populated{false}
+    , status{Status::NOT_RUN}
+    , stats{}
 { }
 
 // Destructor
@@ -63,6 +145,8 @@ Benchmark& Benchmark::operator=(const Benchmark& other) {
     area = other.area;
     benchmark = other.benchmark;
     is_populated = other.is_populated;
+    status = other.status;
+    stats = other.stats;
     return *this;
 }
 
@@ -72,22 +156,29 @@ Benchmark& Benchmark::operator=(Benchmark&& other) {
     area = std::move(other.area);
     benchmark = std::move(other.benchmark);
     is_populated = std::move(other.is_populated);
+    status = std::move(other.status);
+    stats = std::move(other.stats);
     return *this;
 }
 /* }}} */
 
 Architecture Architecture::random(const std::vector<Benchmark>& benchmarks) {
+    return random(Random::thread_stream(), benchmarks);
+}
+
+Architecture Architecture::random(Philox& rng,
+                                  const std::vector<Benchmark>& benchmarks) {
     Architecture arch;
-    arch.K = k_rgen(gen);
-    arch.N = n_rgen(gen);
-    arch.W = w_rgen(gen);
-    // Routing channel width must be even for unidirectional
-    arch.W = arch.W % 2 == 0 ? arch.W : arch.W + 1;
+    arch.set_genome(Genome::random(rng));
     arch.bench = benchmarks;
 
     return arch;
 }
 
+unsigned Architecture::cluster_inputs(unsigned K, unsigned N) {
+    return (K / 2) * (N + 1);
+}
+
 std::string Benchmark::to_s(unsigned indent) const {
     std::ostringstream os;
     // Whitespace for indentation
@@ -99,6 +190,26 @@ std::string Benchmark::to_s(unsigned indent) const {
     os << indent_str << "  " << std::setw(13) << std::left
         << "Area:" << area;
 
+    if (status != Status::SUCCESS) {
+        return os.str();
+    }
+
+    os << std::endl;
+    os << indent_str << "  " << std::setw(13) << std::left
+        << "Pack time:" << stats.pack_time << " s" << std::endl;
+    os << indent_str << "  " << std::setw(13) << std::left
+        << "Place time:" << stats.place_time << " s" << std::endl;
+    os << indent_str << "  " << std::setw(13) << std::left
+        << "Route time:" << stats.route_time << " s" << std::endl;
+    os << indent_str << "  " << std::setw(13) << std::left
+        << "Route iters:" << stats.route_iterations << std::endl;
+    os << indent_str << "  " << std::setw(13) << std::left
+        << "Wirelength:" << stats.wirelength << std::endl;
+    os << indent_str << "  " << std::setw(13) << std::left
+        << "Peak RSS:" << stats.peak_rss << " kB" << std::endl;
+    os << indent_str << "  " << std::setw(13) << std::left
+        << "CPU time:" << stats.cpu_time << " s";
+
     return os.str();
 }
 
@@ -110,6 +221,8 @@ Architecture::Architecture()
     , W{UNSET}
     , bench{}
     , arch_file{}
+    , arch_fd{-1}
+    , arch_xml{}
 { }
 
 Architecture::Architecture(const std::vector<Benchmark>& bench)
@@ -118,6 +231,8 @@ Architecture::Architecture(const std::vector<Benchmark>& bench)
     , W{UNSET}
     , bench{bench}
     , arch_file{}
+    , arch_fd{-1}
+    , arch_xml{}
 { }
 
 // Copy constructor
@@ -126,7 +241,10 @@ Architecture::Architecture(const Architecture& other)
     , N{other.N}
     , W{other.W}
     , bench{other.bench}
-    , arch_file{other.arch_file}
+    // A memfd path belongs to the fd of other, which is not copied
+    , arch_file{other.arch_fd == -1 ? other.arch_file : std::string{}}
+    , arch_fd{-1}
+    , arch_xml{}
 { }
 
 // Move constructor
@@ -136,11 +254,18 @@ Architecture::Architecture(Architecture&& other)
     , W{std::move(other.W)}
     , bench{std::move(other.bench)}
     , arch_file{std::move(other.arch_file)}
-{ }
+    , arch_fd{other.arch_fd}
+    , arch_xml{std::move(other.arch_xml)}
+{
+    other.arch_fd = -1;
+}
 
 // Destructor
-Architecture::~Architecture()
-{ }
+Architecture::~Architecture() {
+    if (arch_fd != -1) {
+        close(arch_fd);
+    }
+}
 
 // Assignment operator
 Architecture& Architecture::operator=(const Architecture& other) {
@@ -148,7 +273,13 @@ Architecture& Architecture::operator=(const Architecture& other) {
     N = other.N;
     W = other.W;
     bench = other.bench;
-    arch_file = other.arch_file;
+    // A memfd path belongs to the fd of other, which is not copied
+    arch_file = other.arch_fd == -1 ? other.arch_file : std::string{};
+    if (arch_fd != -1) {
+        close(arch_fd);
+        arch_fd = -1;
+    }
+    arch_xml.clear();
     return *this;
 }
 
@@ -159,30 +290,42 @@ Architecture& Architecture::operator=(Architecture&& other) {
     W = std::move(other.W);
     bench = std::move(other.bench);
     arch_file = std::move(other.arch_file);
+    std::swap(arch_fd, other.arch_fd);
+    arch_xml = std::move(other.arch_xml);
     return *this;
 }
 /* }}} */
 
 void Architecture::mutate(const float amount) {
-    std::normal_distribution<float> k_dist(K, K * amount);
-    std::normal_distribution<float> w_dist(W, W * amount);
-    std::normal_distribution<float> n_dist(N, N * amount);
-    K = static_cast<decltype(K)>(k_dist(gen));
-    W = static_cast<decltype(W)>(w_dist(gen));
-    W = W % 2 == 0 ? W : W + 1;
-    N = static_cast<decltype(N)>(n_dist(gen));
+    mutate(amount, Random::thread_stream());
+}
+
+void Architecture::mutate(const float amount, Philox& rng) {
+    Genome::Values values = genome();
+    Genome::mutate(values, amount, rng);
+    set_genome(values);
+}
+
+Architecture::Genome::Values Architecture::genome() const {
+    Genome::Values values;
+    values[GENE_K] = K;
+    values[GENE_N] = N;
+    values[GENE_W] = W;
+    return values;
+}
+
+void Architecture::set_genome(const Genome::Values& values) {
+    K = values[GENE_K];
+    N = values[GENE_N];
+    W = values[GENE_W];
 }
 
 bool Architecture::operator==(const Architecture& other) const {
-    return K == other.K
-        && N == other.N
-        && W == other.W;
+    return Genome::equal(genome(), other.genome());
 }
 
 bool Architecture::operator!=(const Architecture& other) const {
-    return K != other.K
-        || N != other.N
-        || W != other.W;
+    return !(*this == other);
 }
 
 std::ostream& operator<<(std::ostream& os, const Architecture& a) {
@@ -205,14 +348,16 @@ std::ostream& operator<<(std::ostream& os, const Architecture& a) {
     return os;
 }
 
-std::string Architecture::make_arch_file() {
+std::string Architecture::make_arch_file(const Workspace& workspace) {
     char folder_buf[80];
     std::sprintf(folder_buf,
-            "./%d_%d_%d",
+            "%d_%d_%d",
             K, N, W);
-#pragma omp critical
-    mkdir(folder_buf, 0700);
-    dir = std::string{folder_buf};
+    dir = workspace.make_job_dir(folder_buf);
+    if (dir.empty()) {
+        arch_file.clear();
+        return arch_file;
+    }
 
     // Construct delay matrix based on K
     std::string line, temp = "2.690e-10";
@@ -228,15 +373,12 @@ std::string Architecture::make_arch_file() {
         {"TEMP_DELAY", temp},
         {"TEMP_N", "\"" + std::to_string(N) + "\" "},
         {"TEMP_N_RANGE", std::to_string(N - 1) + ":0"},
-        {"CLB_IN", "\"" + std::to_string((K / 2) * (N + 1)) + "\" "}
+        {"CLB_IN", "\"" + std::to_string(cluster_inputs(K, N)) + "\" "}
     };
 
-    char arch_file_buf[128];
-    std::sprintf(arch_file_buf, "%s/%d_%d_%d.xml", dir.c_str(), K, N, W);
-    arch_file = std::string{arch_file_buf};
-    // Open the files we need to read and write
-    std::ifstream is("../arch_template.xml");
-    std::ofstream os(arch_file);
+    // Open the template and render it in memory
+    std::ifstream is(workspace.arch_template());
+    std::ostringstream os;
     std::stringstream ss;
 
     // Read to the end of the template
@@ -264,7 +406,19 @@ std::string Architecture::make_arch_file() {
         ss.str(std::string());
         ss.clear();
     }
-    os.close();
+    arch_xml = os.str();
+
+    if (workspace.use_memfd()) {
+        arch_fd = make_memfd(folder_buf, arch_xml);
+        if (arch_fd != -1) {
+            arch_file = "/proc/self/fd/" + std::to_string(arch_fd);
+            return arch_file;
+        }
+    }
+
+    if (!write_arch_file()) {
+        arch_file.clear();
+    }
 
     return arch_file;
 }
@@ -275,86 +429,91 @@ inline std::string get_basename(const std::string& path) {
     return path.substr(start, len);
 }
 
-void Architecture::run_benchmarks(const std::string& vtr_path) {
-    // If this is the first generation, also save the results as reference
-    if (reference_results.empty()) {
-        reference_results.resize(bench.size());
-        // Fill with unpopulated results
-        std::generate(reference_results.begin(),
-                      reference_results.end(),
-                      []() { return Benchmark(); });
-    }
+void Benchmark::set_failed(Status why) {
+    crit_path = FAILED;
+    area = FAILED;
+    is_populated = true;
+    status = why;
+}
 
+void Architecture::run_benchmarks(const std::string& vtr_path,
+                                  const Workspace& workspace,
+                                  const RouteMonitor::Rule& route_rule,
+                                  std::uint64_t job) {
     // Don't need to rerun flow
     if (already_run()) {
         return;
     }
 
+    // make_arch_file failed, possibly after making the job directory
+    if (arch_file.empty()) {
+        for (Benchmark& b : bench) {
+            b.set_failed(Benchmark::Status::ERROR);
+        }
+        if (!dir.empty()) {
+            workspace.reclaim(dir);
+        }
+        return;
+    }
+
     std::string path;
 
     // Run each benchmark
     for (unsigned i = 0; i < bench.size(); i++) {
         Benchmark& b = bench[i];
         path = dir + '/' + get_basename(b.get_filename());
-#pragma omp critical(filesystem)
         mkdir(path.c_str(), 0700);
         path += '/';
-        // The command to give to popen
-        char command_abc[512];
-        char command_vpr[512];
-        std::sprintf(command_abc,
-                "%svtr_flow/scripts/run_vtr_flow.pl %s %s " \
-                "-starting_stage abc -ending_stage abc -keep_intermediate_files " \
-                "-keep_result_files -temp_dir %s 1>/dev/null 2>&1",
-                vtr_path.c_str(),
-                b.get_filename().c_str(),
-                arch_file.c_str(),
-                path.c_str());
-
-#ifdef DEBUG
-#pragma omp critical(print)
-        std::cout << "Running ABC with: " << command_abc << std::endl;
-#endif
-
-        system(command_abc);
 
         std::string new_blif = path + get_basename(b.get_filename()) + ".abc.blif";
-        if (access(new_blif.c_str(), F_OK) == -1) {
-            b.crit_path = Benchmark::FAILED;
-            b.area = Benchmark::FAILED;
-            b.is_populated = true;
+        bool abc_ok = run_abc(b, vtr_path, workspace, path, new_blif);
+
+        // The flow script may not accept the memfd path; try again with a
+        // file, and only give up on memfd if that is what made it work
+        if (!abc_ok && arch_fd != -1 && write_arch_file()) {
+            abc_ok = run_abc(b, vtr_path, workspace, path, new_blif);
+            if (abc_ok) {
+                workspace.reject_memfd();
+            }
+        }
+
+        if (!abc_ok) {
+            b.set_failed(Benchmark::Status::ERROR);
             continue;
         }
 
+        // The seeds only depend on the seed of the run, the job and the
+        // benchmark
+        Philox rng = Random::stream(Random::Domain::JOB, job);
+        rng.discard(i * BENCH_ITER);
+
         // Run the benchmark multiple times
         for (unsigned j = 0; j < BENCH_ITER; j++) {
-            int seed = rd();
-            if (seed < 0) {
-                seed = -1 * seed;
-            } else if (seed == 0) {
-                seed++;
-            }
-            std::sprintf(command_vpr,
-                    "%s/vpr/vpr %s %s -route_chan_width %d -seed %d 2>/dev/null",
-                    vtr_path.c_str(),
-                    arch_file.c_str(),
-                    new_blif.c_str(),
-                    W, seed);
-            std::string command{command_vpr};
+            int seed = 1 + rng() % (INT_MAX - 1);
 
-#ifdef DEBUG
-#pragma omp critical(print)
-            {
-                std::cout << "Running " << b.benchmark << std::endl;
-                std::cout << command << std::endl;
+            RouteMonitor monitor{route_rule};
+            double res_area, res_crit;
+            std::tie(res_area, res_crit) = run_vpr(b, vtr_path, path, new_blif,
+                                                   seed, route_rule, monitor);
+
+            // Same for VPR. If it did not even get to packing, it may have
+            // rejected the memfd path.
+            if (res_area == Benchmark::FAILED && b.stats.pack_time == 0
+                    && arch_fd != -1 && write_arch_file()) {
+                monitor = RouteMonitor{route_rule};
+                std::tie(res_area, res_crit) = run_vpr(b, vtr_path, path, new_blif,
+                                                       seed, route_rule, monitor);
+                // Getting to packing means it could read the file
+                if (b.stats.pack_time > 0) {
+                    workspace.reject_memfd();
+                }
             }
-#endif
 
-            // Run vpr
-            std::shared_ptr<FILE> res{popen(command.c_str(), "r"), pclose};
-
-            double res_area, res_crit;
-            std::tie(res_area, res_crit) = b.parse_results(res);
+            if (monitor.abandoned()) {
+                monitor.record();
+                b.set_failed(Benchmark::Status::UNROUTABLE);
+                break;
+            }
 
             // Save the results of the benchmark
             if (b.is_populated) {
@@ -366,6 +525,9 @@ void Architecture::run_benchmarks(const std::string& vtr_path) {
                 b.crit_path = res_crit;
                 b.is_populated = true;
             }
+            b.status = b.failed()
+                ? Benchmark::Status::ERROR
+                : Benchmark::Status::SUCCESS;
 
 #ifdef DEBUG
 #pragma omp critical(print)
@@ -381,78 +543,165 @@ void Architecture::run_benchmarks(const std::string& vtr_path) {
         }
     }
 
-#pragma omp critical(filesystem)
-    system(("rm -rf " + dir + " 2>/dev/null").c_str());
+    if (arch_fd != -1) {
+        close(arch_fd);
+        arch_fd = -1;
+    }
+    arch_xml.clear();
+
+    // Removed in the background
+    workspace.reclaim(dir);
 }
 
-std::pair<double, double> Benchmark::parse_results(const std::shared_ptr<FILE>& res) {
-    double metrics[NUM_METRICS];
-    std::regex reg[NUM_METRICS] = {std::regex(LOGIC_AREA),
-        std::regex(ROUTE_AREA), std::regex(CRIT_PATH)};
-    std::stringstream ss;
-    std::string temp;
-    char line[256];
-    // Search stream until all metrics are found
-    for (size_t i = 0; i < NUM_METRICS;) {
-        // If you get to end of stream, output failure
-        if (!fgets(line, 256, res.get())) {
-            return std::pair<double, double>(FAILED, FAILED);
-        }
-        // If the stat we are looking for is found, parse the line
-        if (std::regex_search(line, reg[i])) {
-            ss << line;
-            while (ss >> temp) {
-                // If the number is represented in scientific notation,
-                // parse it to output a double
-                if (std::regex_match(temp, std::regex(SCIENTIFIC_NOTATION))) {
-                    metrics[i] = atof(temp.substr(0, temp.find('e') + 1).c_str());
-                    int exp = atoi(temp.substr(temp.find('e') + 1).c_str());
-                    while (exp != 0) {
-                        metrics[i] *= 10;
-                        exp--;
-                    }
-                    break;
-                }
-                else if (temp[0] >= '0' && temp[0] <= '9') {
-                    metrics[i] = atof(temp.c_str());
-                    break;
-                }
-            }
-            ss.str(std::string());
-            i++;
-        }
+bool Architecture::run_abc(const Benchmark& b,
+                           const std::string& vtr_path,
+                           const Workspace& workspace,
+                           const std::string& path,
+                           const std::string& new_blif) const {
+    char command_abc[2048];
+    std::sprintf(command_abc,
+            "%svtr_flow/scripts/run_vtr_flow.pl %s %s " \
+            "-starting_stage abc -ending_stage abc -keep_intermediate_files " \
+            "-keep_result_files -temp_dir %s 1>/dev/null 2>&1",
+            vtr_path.c_str(),
+            workspace.input(b.get_filename()).c_str(),
+            arch_file.c_str(),
+            path.c_str());
+
+#ifdef DEBUG
+#pragma omp critical(print)
+    std::cout << "Running ABC with: " << command_abc << std::endl;
+#endif
+
+    system(command_abc);
+
+    return access(new_blif.c_str(), F_OK) != -1;
+}
+
+std::pair<double, double> Architecture::run_vpr(Benchmark& b,
+                                                const std::string& vtr_path,
+                                                const std::string& path,
+                                                const std::string& new_blif,
+                                                int seed,
+                                                const RouteMonitor::Rule& route_rule,
+                                                RouteMonitor& monitor) const {
+    char command_vpr[2048];
+    std::sprintf(command_vpr,
+            "cd %s && %s/vpr/vpr %s %s -route_chan_width %d -seed %d " \
+            "-max_router_iterations %u 2>/dev/null",
+            path.c_str(),
+            vtr_path.c_str(),
+            arch_file.c_str(),
+            new_blif.c_str(),
+            W, seed, route_rule.max_iterations);
+    std::string command{command_vpr};
+
+#ifdef DEBUG
+#pragma omp critical(print)
+    {
+        std::cout << "Running " << b.benchmark << std::endl;
+        std::cout << command << std::endl;
+    }
+#endif
+
+    // Run vpr
+    Subprocess vpr{command};
+
+    double res_area, res_crit;
+    std::tie(res_area, res_crit) = b.parse_results(vpr.output(), &monitor);
+
+    if (monitor.abandoned()) {
+        vpr.kill();
+    }
+    vpr.wait();
+
+    const struct rusage& ru = vpr.usage();
+    b.stats.peak_rss = ru.ru_maxrss;
+    b.stats.cpu_time = ru.ru_utime.tv_sec + ru.ru_stime.tv_sec
+        + (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1e6;
+
+    return std::make_pair(res_area, res_crit);
+}
+
+bool Architecture::write_arch_file() {
+    char arch_file_buf[1024];
+    std::sprintf(arch_file_buf, "%s/%d_%d_%d.xml", dir.c_str(), K, N, W);
+
+    std::ofstream os(arch_file_buf);
+    os << arch_xml;
+    os.close();
+    if (!os) {
+        return false;
+    }
+
+    if (arch_fd != -1) {
+        close(arch_fd);
+        arch_fd = -1;
+    }
+    arch_file = std::string{arch_file_buf};
+
+    return true;
+}
+
+std::pair<double, double> Benchmark::parse_results(FILE* res,
+                                                   RouteMonitor* monitor) {
+    VprParser parser{monitor};
+    bool complete = parser.parse(res);
+
+    stats.pack_time = parser.pack_time();
+    stats.place_time = parser.place_time();
+    stats.route_time = parser.route_time();
+    stats.route_iterations = parser.route_iterations();
+    stats.wirelength = parser.wirelength();
+
+    if (!complete) {
+        return std::pair<double, double>(FAILED, FAILED);
     }
-    return std::pair<double, double>(metrics[0] + metrics[1], metrics[2]);
+    return std::pair<double, double>(parser.area(), parser.crit_path());
 }
 
-double Architecture::vs_ref_crit_path() const {
+double Architecture::vs_ref_crit_path(const Architecture& reference) const {
+    const std::vector<Benchmark>& ref = reference.bench;
     double sum = 0;
     for (unsigned i = 0; i < bench.size(); i++) {
         // If reference value is not set, then there's no performance change
-        if (!reference_results[i].is_populated) {
+        if (i >= ref.size() || !ref[i].is_populated) {
             return 1.0;
         }
 
-        sum += bench[i].crit_path / reference_results[i].crit_path;
+        sum += bench[i].crit_path / ref[i].crit_path;
     }
 
     return sum / bench.size();
 }
 
-double Architecture::vs_ref_area() const {
+double Architecture::vs_ref_area(const Architecture& reference) const {
+    const std::vector<Benchmark>& ref = reference.bench;
     double sum = 0;
     for (unsigned i = 0; i < bench.size(); i++) {
         // If reference value is not set, then there's no performance change
-        if (!reference_results[i].is_populated) {
+        if (i >= ref.size() || !ref[i].is_populated) {
             return 1.0;
         }
 
-        sum += bench[i].area / reference_results[i].area;
+        sum += bench[i].area / ref[i].area;
     }
 
     return sum / bench.size();
 }
 
+double Architecture::fitness(const Architecture& reference) const {
+    return (vs_ref_crit_path(reference) + vs_ref_area(reference)) / 2;
+}
+
+Benchmark::Stats Architecture::total_stats() const {
+    Benchmark::Stats total;
+    for (const Benchmark& b : bench) {
+        total += b.stats;
+    }
+    return total;
+}
+
 bool Architecture::already_run() const {
     return std::all_of(bench.begin(), bench.end(), [](const Benchmark& b) {
                        return b.is_populated;
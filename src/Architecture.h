@@ -7,12 +7,13 @@
 #include <sys/stat.h>
 #include <unistd.h>
 #include <algorithm>
+#include <climits>
+#include <cstdint>
 #include <fstream>
 #include <iomanip>
 #include <memory>
 #include <ostream>
 #include <random>
-#include <regex>
 #include <sstream>
 #include <stdlib.h>
 #include <string>
@@ -22,11 +23,14 @@
 #include <vector>
 #include <iostream>
 
-#define CRIT_PATH "Final critical path:"
-#define LOGIC_AREA "Total used logic block area:"
-#define ROUTE_AREA "Total routing area:"
-#define SCIENTIFIC_NOTATION "[-]?[0-9]+\\.[0-9]+([e][-+][0-9]+)"
-#define NUM_METRICS 3
+#include "Genome.h"
+#include "Philox.h"
+#include "Random.h"
+#include "RouteMonitor.h"
+#include "Subprocess.h"
+#include "VprParser.h"
+#include "Workspace.h"
+
 #define BENCH_ITER 1
 
 class Architecture {
@@ -34,6 +38,44 @@ public:
     struct Benchmark {
         static const double FAILED;
 
+        /* What happened when the benchmark was run */
+        enum class Status {
+            NOT_RUN,
+            SUCCESS,
+            /* ABC or VPR did not produce results */
+            ERROR,
+            /* Routing was abandoned by the RouteMonitor */
+            UNROUTABLE,
+            /* Not run because the AnalyticModel ruled it out */
+            SCREENED,
+            /* Not run because it would not have finished within the budget */
+            OUT_OF_BUDGET
+        };
+
+        /* Where the time and memory went when running VPR */
+        struct Stats {
+            // Default constructor
+            Stats();
+
+            /**
+             * Adds the other stats to these. Times, iterations and
+             * wirelength are summed up; the peak memory is the max of both.
+             */
+            Stats& operator+=(const Stats& other);
+
+            /* Times reported by VPR for each stage, in seconds */
+            double pack_time;
+            double place_time;
+            double route_time;
+            unsigned route_iterations;
+            /* Total wirelength in units of clb segments */
+            double wirelength;
+            /* Peak resident set size of VPR in kB */
+            long peak_rss;
+            /* User and system CPU time of VPR in seconds */
+            double cpu_time;
+        };
+
         /* Constructors, Destructor, and Assignment operators {{{ */
         // Default constructor
         Benchmark();
@@ -59,11 +101,23 @@ public:
 
         /* Method that parses the output of vpr in the form of a string.
          * res: stream of vpr results.
+         * monitor: if given, every line is also passed to the monitor and
+         *          parsing stops as soon as the monitor gives up.
          * output: a pair, with first representing area in minimum transistor
          *         units and second representing critical path in ns. Returns
          *         pair (FAILED, FAILED) if all metrics are not found.
+         * The times, router iterations and wirelength reported by vpr are
+         * stored in stats.
+         */
+        std::pair<double, double> parse_results(FILE* res,
+                                                RouteMonitor* monitor = nullptr);
+
+        /**
+         * Marks this benchmark as run without results.
+         *
+         * \param[in] why the reason there are no results.
          */
-        std::pair<double, double> parse_results(const std::shared_ptr<FILE>& res);
+        void set_failed(Status why);
 
         double get_crit_path() const;
         double get_area() const;
@@ -82,6 +136,22 @@ public:
         double area;
         std::string benchmark;
         bool is_populated;
+        Status status;
+        /* Of the last vpr run */
+        Stats stats;
+    };
+
+    /* The genes and their ranges; the operators are generated from it */
+    using Genome = GenomeDescriptor<
+        Gene<2, 25>,        // K
+        Gene<1, 50>,        // N
+        Gene<2, 250, 2>     // W, even for unidirectional routing
+    >;
+    /* Position of each gene in Genome::Values */
+    enum GeneIndex : unsigned {
+        GENE_K,
+        GENE_N,
+        GENE_W
     };
 
     static const unsigned UNSET;
@@ -89,14 +159,23 @@ public:
     static const std::pair<unsigned, unsigned> N_RANGE;
     static const std::pair<unsigned, unsigned> W_RANGE;
 
-    /* The results used as a reference to measure performance gain */
-    static std::vector<Benchmark> reference_results;
-
     /**
      * \return a randomly generated architecture.
      */
     static Architecture random(const std::vector<Benchmark>& benchmarks = {});
 
+    /**
+     * \return a randomly generated architecture, drawn from the given
+     *         generator.
+     */
+    static Architecture random(Philox& rng,
+                               const std::vector<Benchmark>& benchmarks = {});
+
+    /**
+     * The number of inputs to a cluster (CLB_IN in the template).
+     */
+    static unsigned cluster_inputs(unsigned K, unsigned N);
+
     /* Constructors, Destructor, and Assignment operators {{{ */
     // Default constructor
     Architecture();
@@ -137,11 +216,17 @@ public:
 
     /* Member methods */
 
-    /* Constructs the architecture file */
-    std::string make_arch_file();
+    /* Constructs the architecture file in a new directory of the workspace.
+     * Returns an empty string if the file could not be created. */
+    std::string make_arch_file(const Workspace& workspace = Workspace{});
 
-    /* Run each benchmark and store it in the benchmark object */
-    void run_benchmarks(const std::string& vtr_path);
+    /* Run each benchmark and store it in the benchmark object. Routes that
+     * the rule says will not converge are killed and marked UNROUTABLE.
+     * The VPR seeds are drawn from the Random::Domain::JOB stream of job. */
+    void run_benchmarks(const std::string& vtr_path,
+                        const Workspace& workspace = Workspace{},
+                        const RouteMonitor::Rule& route_rule = {},
+                        std::uint64_t job = 0);
 
     /**
      * Changes the property of this architecture.
@@ -151,7 +236,23 @@ public:
     void mutate(const float amount);
 
     /**
-     * The average ratio of the benchmarks compared to the reference results.
+     * Same as mutate, drawing from the given generator.
+     */
+    void mutate(const float amount, Philox& rng);
+
+    /**
+     * \return K, N and W as genome values.
+     */
+    Genome::Values genome() const;
+
+    /**
+     * Sets K, N and W from genome values.
+     */
+    void set_genome(const Genome::Values& values);
+
+    /**
+     * The average ratio of the benchmarks compared to the results of a
+     * reference architecture that has been run on the same benchmarks.
      * For example, if the following results are observed,
      *
      *        | Ref | This | Ratio
@@ -161,14 +262,26 @@ public:
      *
      * Avg: 0.775
      *
-     * \return the average ratio of the benchmarks compared to the reference
+     * \return the average ratio of the benchmarks compared to the reference,
+     *         or 1 if the reference has no results for a benchmark.
      */
-    double vs_ref_crit_path() const;
+    double vs_ref_crit_path(const Architecture& reference) const;
 
     /**
      * Same as vs_ref_crit_path but for area.
      */
-    double vs_ref_area() const;
+    double vs_ref_area(const Architecture& reference) const;
+
+    /**
+     * The combined performance used to rank architectures. That is, the
+     * average of vs_ref_crit_path and vs_ref_area. The smaller the better.
+     */
+    double fitness(const Architecture& reference) const;
+
+    /**
+     * \return the stats of all benchmarks added together.
+     */
+    Benchmark::Stats total_stats() const;
 
     /**
      * \return true if all benchmarks have been run already.
@@ -184,17 +297,50 @@ public:
     bool operator!=(const Architecture& other) const;
 
 private:
-    static std::random_device rd;
-    static std::mt19937_64 gen;
-    static std::uniform_int_distribution<unsigned> k_rgen;
-    static std::uniform_int_distribution<unsigned> w_rgen;
-    static std::uniform_int_distribution<unsigned> n_rgen;
-
     /* Directory to hold related files */
     std::string dir;
 
-    /* The architecture file that represents the architecture */
+    /* The architecture file that represents the architecture. Either a path
+     * to a file, or /proc/self/fd/N when it is kept in memory. */
     std::string arch_file;
+
+    /* The memfd holding the architecture file, -1 if none. Not copied. */
+    int arch_fd;
+
+    /* Contents of the architecture file until the benchmarks have been run */
+    std::string arch_xml;
+
+    /**
+     * Writes arch_xml to a file in dir, and uses it as the architecture file
+     * instead of the memfd.
+     *
+     * \return true if the file was written.
+     */
+    bool write_arch_file();
+
+    /**
+     * Runs ABC on the benchmark through the VTR flow script.
+     *
+     * \return true if ABC produced new_blif.
+     */
+    bool run_abc(const Benchmark& b,
+                 const std::string& vtr_path,
+                 const Workspace& workspace,
+                 const std::string& path,
+                 const std::string& new_blif) const;
+
+    /**
+     * Runs VPR in path, storing the stats in the benchmark.
+     *
+     * \return pair of area and critical path as returned by parse_results.
+     */
+    std::pair<double, double> run_vpr(Benchmark& b,
+                                      const std::string& vtr_path,
+                                      const std::string& path,
+                                      const std::string& new_blif,
+                                      int seed,
+                                      const RouteMonitor::Rule& route_rule,
+                                      RouteMonitor& monitor) const;
 };
 
 inline double Architecture::Benchmark::get_crit_path() const {
@@ -0,0 +1,137 @@
+#include "ArchiveReader.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstring>
+#include <limits>
+
+/* Constructors, Destructor, and Assignment operators {{{ */
+// Default constructor
+ArchiveReader::Filter::Filter()
+    : min_generation{0}
+    , max_generation{std::numeric_limits<unsigned>::max()}
+    , K{Architecture::UNSET}
+    , N{Architecture::UNSET}
+    , W{Architecture::UNSET}
+    , benchmark{}
+    , success_only{false}
+{ }
+
+ArchiveReader::ArchiveReader(const std::string& path)
+    : data{nullptr}
+    , length{0}
+    , valid{false}
+{
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        return;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == -1
+            || static_cast<std::size_t>(st.st_size) < sizeof(EvaluationArchive::Header)) {
+        close(fd);
+        return;
+    }
+
+    void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping stays valid after the file is closed
+    close(fd);
+    if (addr == MAP_FAILED) {
+        return;
+    }
+    data = static_cast<const char*>(addr);
+    length = st.st_size;
+
+    // Read front to back
+    madvise(addr, length, MADV_SEQUENTIAL);
+
+    const EvaluationArchive::Header* header =
+        reinterpret_cast<const EvaluationArchive::Header*>(data);
+    valid = std::memcmp(header->magic,
+                        EvaluationArchive::MAGIC,
+                        sizeof(EvaluationArchive::MAGIC)) == 0
+        && header->version == EvaluationArchive::VERSION
+        && header->record_size == EvaluationArchive::RECORD_SIZE;
+}
+
+// Destructor
+ArchiveReader::~ArchiveReader() {
+    if (data != nullptr) {
+        munmap(const_cast<char*>(data), length);
+    }
+}
+/* }}} */
+
+bool ArchiveReader::Filter::matches(const Evaluation& e,
+                                    const std::string& benchmark) const {
+    return e.generation >= min_generation
+        && e.generation <= max_generation
+        && (K == Architecture::UNSET || e.K == K)
+        && (N == Architecture::UNSET || e.N == N)
+        && (W == Architecture::UNSET || e.W == W)
+        && (this->benchmark.empty() || benchmark == this->benchmark)
+        && (!success_only || e.status == static_cast<std::uint8_t>(
+                Architecture::Benchmark::Status::SUCCESS));
+}
+
+bool ArchiveReader::ok() const {
+    return valid;
+}
+
+std::size_t ArchiveReader::size() const {
+    if (!valid) {
+        return 0;
+    }
+    return (length - sizeof(EvaluationArchive::Header))
+        / EvaluationArchive::RECORD_SIZE;
+}
+
+const char* ArchiveReader::status_name(unsigned status) {
+    using Status = Architecture::Benchmark::Status;
+    switch (static_cast<Status>(status)) {
+    case Status::NOT_RUN:
+        return "not_run";
+    case Status::SUCCESS:
+        return "success";
+    case Status::ERROR:
+        return "error";
+    case Status::UNROUTABLE:
+        return "unroutable";
+    case Status::SCREENED:
+        return "screened";
+    case Status::OUT_OF_BUDGET:
+        return "out_of_budget";
+    }
+    return "unknown";
+}
+
+void ArchiveReader::write_csv_header(std::ostream& os) {
+    os << "generation,K,N,W,benchmark,status,area,crit_path," \
+        "pack_time,place_time,route_time,route_iters,wirelength," \
+        "peak_rss_kb,cpu_time" << '\n';
+}
+
+void ArchiveReader::write_csv(std::ostream& os,
+                              const Evaluation& e,
+                              const std::string& benchmark) {
+    // Read back as results to compare against, so nothing may be lost
+    os.precision(std::numeric_limits<double>::max_digits10);
+    os << e.generation << ','
+        << e.K << ','
+        << e.N << ','
+        << e.W << ','
+        << benchmark << ','
+        << status_name(e.status) << ','
+        << e.area << ','
+        << e.crit_path << ','
+        << e.pack_time << ','
+        << e.place_time << ','
+        << e.route_time << ','
+        << e.route_iterations << ','
+        << e.wirelength << ','
+        << e.peak_rss << ','
+        << e.cpu_time << '\n';
+}
@@ -0,0 +1,139 @@
+#ifndef ARCHIVE_READER_H_
+#define ARCHIVE_READER_H_
+
+#include "EvaluationArchive.h"
+
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * Reads an EvaluationArchive through a read-only memory mapping, so that
+ * archives of millions of evaluations can be scanned without loading them.
+ */
+class ArchiveReader {
+public:
+    using Evaluation = EvaluationArchive::Evaluation;
+
+    /* Which evaluations to look at. Unset fields match everything. */
+    struct Filter {
+        // Default constructor
+        Filter();
+
+        /**
+         * \return true if the evaluation passes all the conditions.
+         */
+        bool matches(const Evaluation& e, const std::string& benchmark) const;
+
+        unsigned min_generation;
+        unsigned max_generation;
+        unsigned K;
+        unsigned N;
+        unsigned W;
+        /* File name of the benchmark, empty for any */
+        std::string benchmark;
+        /* Only successful runs */
+        bool success_only;
+    };
+
+    /* Constructors, Destructor, and Assignment operators {{{ */
+    /**
+     * Maps the archive. Check ok() before reading.
+     */
+    ArchiveReader(const std::string& path);
+
+    // Copy constructor
+    ArchiveReader(const ArchiveReader& other) = delete;
+
+    // Destructor
+    ~ArchiveReader();
+
+    // Assignment operator
+    ArchiveReader& operator=(const ArchiveReader& other) = delete;
+    /* }}} */
+
+    /**
+     * \return false if the file could not be mapped or is not an archive.
+     */
+    bool ok() const;
+
+    /**
+     * \return the number of records, including the benchmark names.
+     *         A record that is only partly written is ignored.
+     */
+    std::size_t size() const;
+
+    /**
+     * Calls f(evaluation, benchmark name) for each evaluation that passes
+     * the filter, in the order they were written.
+     *
+     * \return the number of evaluations passed to f.
+     */
+    template<typename F>
+    std::size_t for_each(const Filter& filter, F f) const;
+
+    /**
+     * \return the name of an Architecture::Benchmark::Status.
+     */
+    static const char* status_name(unsigned status);
+
+    /**
+     * Writes the column names of write_csv.
+     */
+    static void write_csv_header(std::ostream& os);
+
+    /**
+     * Writes one evaluation as a line of CSV, with every digit of the
+     * area and critical path.
+     */
+    static void write_csv(std::ostream& os,
+                          const Evaluation& e,
+                          const std::string& benchmark);
+
+private:
+    const char* data;
+    std::size_t length;
+    bool valid;
+};
+
+template<typename F>
+std::size_t ArchiveReader::for_each(const Filter& filter, F f) const {
+    if (!valid) {
+        return 0;
+    }
+
+    // Names are assigned per run, so they are looked up as they come
+    std::vector<std::string> names;
+    std::size_t cnt = 0;
+    const char* rec = data + sizeof(EvaluationArchive::Header);
+
+    for (std::size_t i = 0; i < size(); i++, rec += EvaluationArchive::RECORD_SIZE) {
+        if (static_cast<unsigned char>(rec[0]) == EvaluationArchive::NAME) {
+            const EvaluationArchive::Name* name =
+                reinterpret_cast<const EvaluationArchive::Name*>(rec);
+            if (name->benchmark >= names.size()) {
+                names.resize(name->benchmark + 1);
+            }
+            names[name->benchmark].assign(name->name,
+                                          strnlen(name->name, sizeof(name->name)));
+            continue;
+        }
+
+        const Evaluation* e = reinterpret_cast<const Evaluation*>(rec);
+        static const std::string unknown;
+        const std::string& benchmark = e->benchmark < names.size()
+            ? names[e->benchmark]
+            : unknown;
+
+        if (filter.matches(*e, benchmark)) {
+            f(*e, benchmark);
+            cnt++;
+        }
+    }
+
+    return cnt;
+}
+
+#endif /* end of include guard */
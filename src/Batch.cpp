@@ -0,0 +1,270 @@
+#include "Batch.h"
+
+#include "ArchiveReader.h"
+
+#include <algorithm>
+#include <cctype>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_set>
+
+using Values = Architecture::Genome::Values;
+
+namespace {
+
+/* Names of the genes in headers and sweeps, and their steps */
+const char* const GENE_NAMES[] = {"K", "N", "W"};
+const unsigned GENE_STEPS[] = {
+    Architecture::Genome::GeneAt<Architecture::GENE_K>::step,
+    Architecture::Genome::GeneAt<Architecture::GENE_N>::step,
+    Architecture::Genome::GeneAt<Architecture::GENE_W>::step
+};
+
+std::vector<std::string> split(const std::string& text, const std::string& separators) {
+    std::vector<std::string> fields;
+    std::string field;
+    for (char c : text) {
+        if (separators.find(c) != std::string::npos) {
+            if (!field.empty()) {
+                fields.push_back(field);
+            }
+            field.clear();
+        }
+        else {
+            field += c;
+        }
+    }
+    if (!field.empty()) {
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+/* Whether text is a non-negative whole number, stored in value if so */
+bool parse_unsigned(const std::string& text, unsigned& value) {
+    if (text.empty() || text.size() > 9
+        || !std::all_of(text.begin(), text.end(),
+                        [](char c) { return std::isdigit(static_cast<unsigned char>(c)); })) {
+        return false;
+    }
+    value = static_cast<unsigned>(std::stoul(text));
+    return true;
+}
+
+unsigned gene_index(const std::string& name) {
+    for (unsigned g = 0; g < Architecture::Genome::size; g++) {
+        if (name == GENE_NAMES[g]) {
+            return g;
+        }
+    }
+    return Architecture::Genome::size;
+}
+
+/* What the run time mostly grows with, in order */
+std::tuple<unsigned, unsigned, unsigned> cost(const Values& genome) {
+    return std::make_tuple(genome[Architecture::GENE_W],
+                           genome[Architecture::GENE_N],
+                           genome[Architecture::GENE_K]);
+}
+
+std::string to_string(const Values& genome) {
+    std::ostringstream ss;
+    ss << "K=" << genome[Architecture::GENE_K]
+        << ",N=" << genome[Architecture::GENE_N]
+        << ",W=" << genome[Architecture::GENE_W];
+    return ss.str();
+}
+
+}
+
+Batch::Order Batch::parse_order(const std::string& name) {
+    if (name == "given") {
+        return Order::GIVEN;
+    }
+    if (name == "shuffle") {
+        return Order::SHUFFLE;
+    }
+    if (name == "cost") {
+        return Order::COST;
+    }
+    throw std::invalid_argument{"Unknown batch order " + name};
+}
+
+std::vector<Values> Batch::read(std::istream& is) {
+    std::vector<Values> genomes;
+    std::unordered_set<std::uint64_t> seen;
+    // Where K, N and W are, until a header says otherwise
+    std::vector<unsigned> columns{0, 1, 2};
+    bool first = true;
+    std::string line;
+
+    for (unsigned number = 1; std::getline(is, line); number++) {
+        std::vector<std::string> fields = split(line, ", \t\r");
+        if (fields.empty() || fields[0][0] == '#') {
+            continue;
+        }
+
+        unsigned value;
+        if (first && !parse_unsigned(fields[0], value)) {
+            first = false;
+            columns.assign(Architecture::Genome::size, fields.size());
+            for (unsigned c = 0; c < fields.size(); c++) {
+                unsigned g = gene_index(fields[c]);
+                if (g < columns.size()) {
+                    columns[g] = c;
+                }
+            }
+            if (*std::max_element(columns.begin(), columns.end()) == fields.size()) {
+                throw std::invalid_argument{"Line " + std::to_string(number)
+                    + ": the header has no K, N and W columns"};
+            }
+            continue;
+        }
+        first = false;
+
+        Values genome;
+        for (unsigned g = 0; g < genome.size(); g++) {
+            if (columns[g] >= fields.size()
+                || !parse_unsigned(fields[columns[g]], genome[g])) {
+                throw std::invalid_argument{"Line " + std::to_string(number)
+                    + ": no " + GENE_NAMES[g]};
+            }
+        }
+        if (!Architecture::Genome::valid(genome)) {
+            throw std::invalid_argument{"Line " + std::to_string(number)
+                + ": " + to_string(genome) + " is out of range"};
+        }
+        if (seen.insert(Architecture::Genome::key(genome)).second) {
+            genomes.push_back(genome);
+        }
+    }
+    return genomes;
+}
+
+std::vector<Values> Batch::sweep(const std::string& spec) {
+    // First, last and step of each gene
+    std::vector<std::tuple<unsigned, unsigned, unsigned>> ranges(Architecture::Genome::size);
+    std::vector<bool> given(Architecture::Genome::size, false);
+
+    for (const std::string& part : split(spec, ",")) {
+        const std::size_t eq = part.find('=');
+        const unsigned g = gene_index(part.substr(0, eq));
+        if (eq == std::string::npos || g == Architecture::Genome::size || given[g]) {
+            throw std::invalid_argument{"Cannot read " + part + " of the sweep"};
+        }
+        std::vector<std::string> bounds = split(part.substr(eq + 1), ":");
+        unsigned first, last, step = GENE_STEPS[g];
+        if (bounds.empty() || bounds.size() > 3
+            || !parse_unsigned(bounds[0], first)
+            || !parse_unsigned(bounds.size() > 1 ? bounds[1] : bounds[0], last)
+            || (bounds.size() > 2 && !parse_unsigned(bounds[2], step))
+            || step == 0 || last < first) {
+            throw std::invalid_argument{"Cannot read " + part + " of the sweep"};
+        }
+        ranges[g] = std::make_tuple(first, last, step);
+        given[g] = true;
+    }
+    for (unsigned g = 0; g < given.size(); g++) {
+        if (!given[g]) {
+            throw std::invalid_argument{"The sweep has no range for "
+                + std::string{GENE_NAMES[g]}};
+        }
+    }
+
+    // Like an odometer, the last gene turning fastest
+    std::vector<Values> genomes;
+    Values genome;
+    for (unsigned g = 0; g < genome.size(); g++) {
+        genome[g] = std::get<0>(ranges[g]);
+    }
+    while (true) {
+        if (!Architecture::Genome::valid(genome)) {
+            throw std::invalid_argument{"The sweep goes out of range at "
+                + to_string(genome)};
+        }
+        genomes.push_back(genome);
+
+        unsigned g = genome.size();
+        while (g > 0) {
+            g--;
+            genome[g] += std::get<2>(ranges[g]);
+            if (genome[g] <= std::get<1>(ranges[g])) {
+                break;
+            }
+            genome[g] = std::get<0>(ranges[g]);
+            if (g == 0) {
+                return genomes;
+            }
+        }
+    }
+}
+
+std::pair<unsigned, unsigned> Batch::parse_shard(const std::string& spec) {
+    std::vector<std::string> parts = split(spec, "/");
+    unsigned shard, shards;
+    if (parts.size() != 2 || std::count(spec.begin(), spec.end(), '/') != 1
+        || !parse_unsigned(parts[0], shard) || !parse_unsigned(parts[1], shards)
+        || shard >= shards) {
+        throw std::invalid_argument{"Cannot read shard " + spec
+            + " (expected i/n with i < n)"};
+    }
+    return std::make_pair(shard, shards);
+}
+
+std::vector<Batch::Entry> Batch::schedule(const std::vector<Values>& genomes,
+                                          Order order,
+                                          unsigned shard, unsigned shards,
+                                          Philox& rng) {
+    // Every shards-th, so each shard gets a slice of the whole grid
+    std::vector<Entry> entries;
+    for (unsigned i = shard; i < genomes.size(); i += shards) {
+        entries.push_back(Entry{i, genomes[i]});
+    }
+
+    switch (order) {
+    case Order::GIVEN:
+        break;
+
+    case Order::SHUFFLE:
+        std::shuffle(entries.begin(), entries.end(), rng);
+        break;
+
+    case Order::COST:
+        std::stable_sort(entries.begin(), entries.end(),
+                         [](const Entry& a, const Entry& b) {
+            return cost(a.genome) > cost(b.genome);
+        });
+        break;
+    }
+    return entries;
+}
+
+void Batch::write_csv_header(std::ostream& os) {
+    os << "index,K,N,W,benchmark,status,area,crit_path," \
+        "pack_time,place_time,route_time,route_iters,wirelength," \
+        "peak_rss_kb,cpu_time" << '\n';
+}
+
+void Batch::write_csv(std::ostream& os, unsigned index, const Architecture& arch) {
+    // Read back as results to compare against, so nothing may be lost
+    os.precision(std::numeric_limits<double>::max_digits10);
+    for (const Architecture::Benchmark& b : arch.bench) {
+        os << index << ','
+            << arch.K << ','
+            << arch.N << ','
+            << arch.W << ','
+            << b.get_filename() << ','
+            << ArchiveReader::status_name(static_cast<unsigned>(b.status)) << ','
+            << b.area << ','
+            << b.crit_path << ','
+            << b.stats.pack_time << ','
+            << b.stats.place_time << ','
+            << b.stats.route_time << ','
+            << b.stats.route_iterations << ','
+            << b.stats.wirelength << ','
+            << b.stats.peak_rss << ','
+            << b.stats.cpu_time << '\n';
+    }
+}
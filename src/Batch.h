@@ -0,0 +1,98 @@
+#ifndef BATCH_H_
+#define BATCH_H_
+
+#include "Architecture.h"
+#include "Philox.h"
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Lists of architectures to evaluate as they are, without optimising:
+ * hand-picked ones read from a file, or every point of a grid (a sweep).
+ *
+ * Each architecture keeps its position in the whole list, which also picks
+ * its VPR seeds, so a list split into shards over several nodes gives the
+ * same results as running it in one go, and the outputs can be merged by
+ * that index. Results are written in the CSV format of fp-GA-archive, with
+ * the index in place of the generation.
+ */
+class Batch {
+public:
+    /* In which order the architectures of a shard are run */
+    enum class Order {
+        /* As listed */
+        GIVEN,
+        /* Randomly, so that a partial run covers the whole list */
+        SHUFFLE,
+        /* The ones expected to take longest first (widest channels, then
+         * largest clusters), so that no thread is left with a long run at
+         * the end */
+        COST
+    };
+
+    struct Entry {
+        /* Position in the whole list */
+        unsigned index;
+        Architecture::Genome::Values genome;
+    };
+
+    /**
+     * \return the order with the given name (given, shuffle or cost).
+     *         Throws std::invalid_argument for anything else.
+     */
+    static Order parse_order(const std::string& name);
+
+    /**
+     * Reads architectures, one per line. Blank lines and lines starting with
+     * # are skipped. If the first line names columns K, N and W (such as the
+     * output of fp-GA-archive or of a batch), those are used, otherwise the
+     * first three columns. Columns are separated by commas or spaces, and
+     * each architecture is listed once no matter how many benchmarks it has
+     * rows for.
+     *
+     * Throws std::invalid_argument, giving the line, if a line cannot be
+     * read or is not a valid architecture.
+     */
+    static std::vector<Architecture::Genome::Values> read(std::istream& is);
+
+    /**
+     * \return every architecture of a grid given as K=a:b:s,N=a:b:s,W=a:b:s,
+     *         with K varying slowest. The step may be left out (the step of
+     *         the gene), and so may the range (a single value). Throws
+     *         std::invalid_argument if a gene is missing or a value is out
+     *         of range.
+     */
+    static std::vector<Architecture::Genome::Values> sweep(const std::string& spec);
+
+    /**
+     * \return the shard and the number of shards given as i/n, with i < n.
+     *         Throws std::invalid_argument for anything else.
+     */
+    static std::pair<unsigned, unsigned> parse_shard(const std::string& spec);
+
+    /**
+     * \return the architectures of one shard (every shards-th one, starting
+     *         from the shard-th) in the given order.
+     */
+    static std::vector<Entry> schedule(const std::vector<Architecture::Genome::Values>& genomes,
+                                       Order order,
+                                       unsigned shard, unsigned shards,
+                                       Philox& rng);
+
+    /**
+     * Writes the column names of write_csv.
+     */
+    static void write_csv_header(std::ostream& os);
+
+    /**
+     * Writes one line of CSV per benchmark of an architecture that has been
+     * run, with every digit of the area and critical path.
+     */
+    static void write_csv(std::ostream& os, unsigned index, const Architecture& arch);
+};
+
+#endif /* end of include guard */
@@ -0,0 +1,316 @@
+#include "BayesianOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+const unsigned BayesianOptimizer::CANDIDATES = 1024;
+const unsigned BayesianOptimizer::NEIGHBOURHOODS = 4;
+
+namespace {
+
+using Genome = Architecture::Genome;
+
+const unsigned D = Genome::size;
+
+/* What the length scale and noise are picked from, in unit cube and
+ * standardised fitness units */
+const double LENGTH_SCALES[] = {0.05, 0.1, 0.2, 0.4, 0.8};
+const double NOISES[] = {1e-4, 1e-2, 1e-1};
+
+const double PI = 3.14159265358979323846;
+
+/**
+ * Cholesky factorisation of the symmetric n x n matrix in place (lower
+ * triangle, row-major).
+ *
+ * \return false if it is not positive definite.
+ */
+bool cholesky(std::vector<double>& a, unsigned n) {
+    for (unsigned i = 0; i < n; i++) {
+        for (unsigned j = 0; j <= i; j++) {
+            double sum = a[i * n + j];
+            for (unsigned k = 0; k < j; k++) {
+                sum -= a[i * n + k] * a[j * n + k];
+            }
+            if (i == j) {
+                if (sum <= 0) {
+                    return false;
+                }
+                a[i * n + i] = std::sqrt(sum);
+            }
+            else {
+                a[i * n + j] = sum / a[j * n + j];
+            }
+        }
+    }
+    return true;
+}
+
+/* Solves L x = b in place */
+void forward(const std::vector<double>& l, unsigned n, std::vector<double>& b) {
+    for (unsigned i = 0; i < n; i++) {
+        double sum = b[i];
+        for (unsigned k = 0; k < i; k++) {
+            sum -= l[i * n + k] * b[k];
+        }
+        b[i] = sum / l[i * n + i];
+    }
+}
+
+/* Solves L^T x = b in place */
+void backward(const std::vector<double>& l, unsigned n, std::vector<double>& b) {
+    for (unsigned i = n; i-- > 0; ) {
+        double sum = b[i];
+        for (unsigned k = i + 1; k < n; k++) {
+            sum -= l[k * n + i] * b[k];
+        }
+        b[i] = sum / l[i * n + i];
+    }
+}
+
+double dot(const std::vector<double>& a, const std::vector<double>& b) {
+    double sum = 0;
+    for (unsigned i = 0; i < a.size() && i < b.size(); i++) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+}
+
+/* Constructors, Destructor, and Assignment operators {{{ */
+// Default constructor
+BayesianOptimizer::BayesianOptimizer()
+    : points{}
+    , fitnesses{}
+    , index{}
+    , excluded{}
+    , fitted{false}
+    , length_scale{LENGTH_SCALES[0]}
+    , noise{NOISES[0]}
+    , y_mean{0}
+    , y_deviation{1}
+    , factor{}
+    , alpha{}
+{ }
+/* }}} */
+
+void BayesianOptimizer::add(const Genome::Values& genome, double fitness) {
+    fitted = false;
+    const std::uint64_t key = Genome::key(genome);
+    auto found = index.find(key);
+    if (found != index.end()) {
+        fitnesses[found->second] = fitness;
+        return;
+    }
+    index[key] = fitnesses.size();
+    fitnesses.push_back(fitness);
+    const std::vector<double> point = Genome::to_unit(genome);
+    points.insert(points.end(), point.begin(), point.end());
+}
+
+void BayesianOptimizer::exclude(const Genome::Values& genome) {
+    excluded.insert(Genome::key(genome));
+}
+
+unsigned BayesianOptimizer::size() const {
+    return fitnesses.size();
+}
+
+BayesianOptimizer::Prediction BayesianOptimizer::predict(const Genome::Values& genome) {
+    fit();
+    const std::vector<double> point = Genome::to_unit(genome);
+    std::vector<double> k(size());
+    for (unsigned i = 0; i < size(); i++) {
+        k[i] = kernel(point.data(), &points[i * D]);
+    }
+    const double mean = dot(k, alpha);
+    forward(factor, size(), k);
+    const double variance = std::max(1 - dot(k, k), 0.0);
+    return Prediction{y_mean + mean * y_deviation,
+                      std::sqrt(variance) * y_deviation};
+}
+
+std::vector<Genome::Values> BayesianOptimizer::propose(unsigned count, Philox& rng) {
+    std::vector<Genome::Values> batch;
+    if (count == 0) {
+        return batch;
+    }
+
+    // Next to the best ones, and anywhere
+    std::unordered_set<std::uint64_t> seen{excluded};
+    for (const auto& known : index) {
+        seen.insert(known.first);
+    }
+    std::vector<Genome::Values> candidates;
+    std::vector<unsigned> order(size());
+    for (unsigned i = 0; i < size(); i++) {
+        order[i] = i;
+    }
+    const unsigned best = std::min<unsigned>(NEIGHBOURHOODS, size());
+    std::partial_sort(order.begin(), order.begin() + best, order.end(),
+                      [this](unsigned a, unsigned b) {
+        return fitnesses[a] != fitnesses[b] ? fitnesses[a] < fitnesses[b] : a < b;
+    });
+    for (unsigned j = 0; j < best; j++) {
+        const Genome::Values genome = Genome::from_unit(std::vector<double>(
+            points.begin() + order[j] * D, points.begin() + (order[j] + 1) * D));
+        for (const Genome::Values& neighbour : Genome::neighbours(genome)) {
+            if (seen.insert(Genome::key(neighbour)).second) {
+                candidates.push_back(neighbour);
+            }
+        }
+    }
+    for (unsigned tries = 0; candidates.size() < CANDIDATES
+         && tries < 4 * CANDIDATES; tries++) {
+        const Genome::Values genome = Genome::random(rng);
+        if (seen.insert(Genome::key(genome)).second) {
+            candidates.push_back(genome);
+        }
+    }
+
+    if (size() < 2) {
+        // Nothing to fit to, the random ones come after the neighbours
+        std::vector<Genome::Values> random(candidates.end()
+                                           - std::min<std::size_t>(count, candidates.size()),
+                                           candidates.end());
+        return random;
+    }
+
+    fit();
+    const unsigned n = size();
+    double best_y = std::numeric_limits<double>::infinity();
+    for (double y : fitnesses) {
+        best_y = std::min(best_y, (y - y_mean) / y_deviation);
+    }
+
+    // L^-1 k for each candidate, which grows by one with every pick
+    std::vector<std::vector<double>> v(candidates.size());
+    std::vector<std::vector<double>> unit(candidates.size());
+    std::vector<double> mean(candidates.size());
+    std::vector<double> variance(candidates.size());
+    for (unsigned c = 0; c < candidates.size(); c++) {
+        unit[c] = Genome::to_unit(candidates[c]);
+        v[c].resize(n);
+        for (unsigned i = 0; i < n; i++) {
+            v[c][i] = kernel(unit[c].data(), &points[i * D]);
+        }
+        mean[c] = dot(v[c], alpha);
+        forward(factor, n, v[c]);
+        variance[c] = 1 - dot(v[c], v[c]);
+    }
+
+    std::vector<bool> picked(candidates.size(), false);
+    while (batch.size() < count && batch.size() < candidates.size()) {
+        unsigned pick = 0;
+        double best_ei = -1;
+        for (unsigned c = 0; c < candidates.size(); c++) {
+            if (picked[c]) {
+                continue;
+            }
+            double ei = expected_improvement(mean[c],
+                                             std::sqrt(std::max(variance[c], 0.0)),
+                                             best_y);
+            if (ei > best_ei) {
+                best_ei = ei;
+                pick = c;
+            }
+        }
+        picked[pick] = true;
+        batch.push_back(candidates[pick]);
+
+        // Believe the prediction at the pick: the factor gets a row for it
+        const double d = std::sqrt(std::max(1 + noise - dot(v[pick], v[pick]), noise));
+        const std::vector<double> row = v[pick];
+        for (unsigned c = 0; c < candidates.size(); c++) {
+            if (picked[c]) {
+                continue;
+            }
+            const double next = (kernel(unit[c].data(), unit[pick].data())
+                                 - dot(row, v[c])) / d;
+            v[c].push_back(next);
+            variance[c] -= next * next;
+        }
+    }
+    return batch;
+}
+
+double BayesianOptimizer::expected_improvement(double mean, double deviation,
+                                               double best) {
+    if (deviation <= 0) {
+        return std::max(best - mean, 0.0);
+    }
+    const double z = (best - mean) / deviation;
+    const double cdf = 0.5 * std::erfc(-z / std::sqrt(2.0));
+    const double pdf = std::exp(-0.5 * z * z) / std::sqrt(2 * PI);
+    return (best - mean) * cdf + deviation * pdf;
+}
+
+/* Private methods */
+
+void BayesianOptimizer::fit() {
+    if (fitted) {
+        return;
+    }
+    const unsigned n = size();
+
+    y_mean = 0;
+    for (double y : fitnesses) {
+        y_mean += y;
+    }
+    y_mean = n > 0 ? y_mean / n : 0;
+    double var = 0;
+    for (double y : fitnesses) {
+        var += (y - y_mean) * (y - y_mean);
+    }
+    y_deviation = n > 1 && var > 0 ? std::sqrt(var / n) : 1;
+    std::vector<double> y(n);
+    for (unsigned i = 0; i < n; i++) {
+        y[i] = (fitnesses[i] - y_mean) / y_deviation;
+    }
+
+    // The most likely of the grid
+    double best_likelihood = -std::numeric_limits<double>::infinity();
+    double best_scale = LENGTH_SCALES[0];
+    for (double scale : LENGTH_SCALES) {
+        for (double s2 : NOISES) {
+            length_scale = scale;
+            std::vector<double> l(n * n);
+            for (unsigned i = 0; i < n; i++) {
+                for (unsigned j = 0; j <= i; j++) {
+                    l[i * n + j] = kernel(&points[i * D], &points[j * D])
+                        + (i == j ? s2 : 0);
+                }
+            }
+            if (!cholesky(l, n)) {
+                continue;
+            }
+            std::vector<double> a = y;
+            forward(l, n, a);
+            double likelihood = -0.5 * dot(a, a) - 0.5 * n * std::log(2 * PI);
+            for (unsigned i = 0; i < n; i++) {
+                likelihood -= std::log(l[i * n + i]);
+            }
+            if (likelihood > best_likelihood) {
+                best_likelihood = likelihood;
+                backward(l, n, a);
+                factor.swap(l);
+                alpha.swap(a);
+                best_scale = scale;
+                noise = s2;
+            }
+        }
+    }
+    length_scale = best_scale;
+    fitted = true;
+}
+
+double BayesianOptimizer::kernel(const double* a, const double* b) const {
+    double sum = 0;
+    for (unsigned d = 0; d < D; d++) {
+        sum += (a[d] - b[d]) * (a[d] - b[d]);
+    }
+    const double r = std::sqrt(5 * sum) / length_scale;
+    return (1 + r + r * r / 3) * std::exp(-r);
+}
@@ -0,0 +1,102 @@
+#ifndef BAYESIAN_OPTIMIZER_H_
+#define BAYESIAN_OPTIMIZER_H_
+
+#include "Architecture.h"
+#include "Philox.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * Gaussian process Bayesian optimisation of the fitness over the genome.
+ *
+ * The process has a Matern 5/2 kernel over the unit cube coordinates of the
+ * genome (see GenomeDescriptor::to_unit) and is fitted to the standardised
+ * fitness of every architecture run so far, picking its length scale and
+ * noise by marginal likelihood from a small grid. A batch is chosen by
+ * expected improvement with the kriging believer heuristic: after each pick
+ * the process is conditioned on its own prediction there, which leaves the
+ * mean alone and only shrinks the uncertainty around the pick, so the rest of
+ * the batch goes elsewhere.
+ */
+class BayesianOptimizer {
+public:
+    struct Prediction {
+        double mean;
+        double deviation;
+    };
+
+    /* Random candidates the acquisition is maximised over */
+    static const unsigned CANDIDATES;
+    /* Best architectures whose neighbours are always candidates */
+    static const unsigned NEIGHBOURHOODS;
+
+    /* Constructors, Destructor, and Assignment operators {{{ */
+    // Default constructor
+    BayesianOptimizer();
+    /* }}} */
+
+    /**
+     * Adds the fitness of an architecture that has been run, or replaces
+     * it if it is already there.
+     */
+    void add(const Architecture::Genome::Values& genome, double fitness);
+
+    /**
+     * Keeps an architecture out of future batches, e.g. one that failed.
+     */
+    void exclude(const Architecture::Genome::Values& genome);
+
+    /**
+     * \return the number of architectures added.
+     */
+    unsigned size() const;
+
+    /**
+     * \return the prediction of the fitted process, in fitness units. Only
+     *         meaningful with 2 or more architectures added.
+     */
+    Prediction predict(const Architecture::Genome::Values& genome);
+
+    /**
+     * \return up to count distinct architectures that have not been added
+     *         or excluded, best expected improvement first. Random ones
+     *         while there are less than 2 architectures to fit to.
+     */
+    std::vector<Architecture::Genome::Values> propose(unsigned count, Philox& rng);
+
+    /**
+     * \return the expected improvement below best of a normal prediction.
+     */
+    static double expected_improvement(double mean, double deviation, double best);
+
+private:
+    /* Unit cube coordinates, one point after the other, and fitness */
+    std::vector<double> points;
+    std::vector<double> fitnesses;
+    /* Genome key to position */
+    std::unordered_map<std::uint64_t, unsigned> index;
+    std::unordered_set<std::uint64_t> excluded;
+
+    /* The fitted process, for the standardised fitnesses */
+    bool fitted;
+    double length_scale;
+    double noise;
+    double y_mean;
+    double y_deviation;
+    /* Cholesky factor of the kernel matrix plus noise, row-major */
+    std::vector<double> factor;
+    /* The factor solved against the fitnesses */
+    std::vector<double> alpha;
+
+    /**
+     * Fits the process to the architectures added, unless already done.
+     */
+    void fit();
+
+    double kernel(const double* a, const double* b) const;
+};
+
+#endif /* end of include guard */
@@ -0,0 +1,267 @@
+#include "EvaluationArchive.h"
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+const char EvaluationArchive::MAGIC[8] = {'F', 'P', 'G', 'A', 'E', 'V', 'A', 'L'};
+const std::uint32_t EvaluationArchive::VERSION = 1;
+
+static_assert(sizeof(EvaluationArchive::Evaluation) == EvaluationArchive::RECORD_SIZE,
+              "Evaluation records must be RECORD_SIZE bytes");
+static_assert(sizeof(EvaluationArchive::Name) == EvaluationArchive::RECORD_SIZE,
+              "Name records must be RECORD_SIZE bytes");
+
+namespace {
+
+bool write_all(int fd, const char* data, std::size_t size) {
+    while (size > 0) {
+        ssize_t ret = write(fd, data, size);
+        if (ret == -1 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            return false;
+        }
+        data += ret;
+        size -= ret;
+    }
+    return true;
+}
+
+bool lock_exclusive(int fd) {
+    while (flock(fd, LOCK_EX) == -1) {
+        if (errno != EINTR) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+/* Constructors, Destructor, and Assignment operators {{{ */
+EvaluationArchive::EvaluationArchive(const std::string& path)
+    : fd{-1}
+    , mtx{}
+    , queued{}
+    , drained{}
+    , pending{}
+    , ids{}
+    , busy{false}
+    , stopping{false}
+    , error{false}
+    , count{0}
+    , end{0}
+    , writer{}
+{
+    fd = open(path.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd == -1) {
+        return;
+    }
+
+    // Another run may be creating the same archive
+    if (!lock_exclusive(fd)) {
+        close(fd);
+        fd = -1;
+        return;
+    }
+
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    struct stat st;
+    bool ok = fstat(fd, &st) == 0;
+    if (ok && st.st_size == 0) {
+        // New archive
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.record_size = RECORD_SIZE;
+        ok = write_all(fd, reinterpret_cast<const char*>(&header), sizeof(header))
+            && fstat(fd, &st) == 0;
+    }
+    else if (ok) {
+        // Not ours, leave it alone
+        ok = pread(fd, &header, sizeof(header), 0) == sizeof(header)
+            && std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0
+            && header.version == VERSION
+            && header.record_size == RECORD_SIZE;
+    }
+    end = st.st_size;
+    flock(fd, LOCK_UN);
+
+    if (!ok) {
+        close(fd);
+        fd = -1;
+        return;
+    }
+
+    writer = std::thread{&EvaluationArchive::run, this};
+}
+
+// Destructor
+EvaluationArchive::~EvaluationArchive() {
+    {
+        std::lock_guard<std::mutex> lock{mtx};
+        stopping = true;
+    }
+    queued.notify_all();
+
+    if (writer.joinable()) {
+        writer.join();
+    }
+    if (fd != -1) {
+        close(fd);
+    }
+}
+/* }}} */
+
+bool EvaluationArchive::ok() const {
+    std::lock_guard<std::mutex> lock{mtx};
+    return fd != -1 && !error;
+}
+
+void EvaluationArchive::append(unsigned generation, const Architecture& arch) {
+    if (fd == -1) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{mtx};
+        for (const Architecture::Benchmark& b : arch.bench) {
+            if (!b.is_populated) {
+                continue;
+            }
+
+            Record rec;
+            std::memset(&rec, 0, sizeof(rec));
+            Evaluation& e = rec.evaluation;
+            e.type = EVALUATION;
+            e.status = static_cast<std::uint8_t>(b.status);
+            e.benchmark = id_of(b.get_filename());
+            e.generation = generation;
+            e.K = arch.K;
+            e.N = arch.N;
+            e.W = arch.W;
+            e.route_iterations = b.stats.route_iterations;
+            e.peak_rss = b.stats.peak_rss;
+            e.wirelength = b.stats.wirelength;
+            e.area = b.area;
+            e.crit_path = b.crit_path;
+            e.pack_time = b.stats.pack_time;
+            e.place_time = b.stats.place_time;
+            e.route_time = b.stats.route_time;
+            e.cpu_time = b.stats.cpu_time;
+            pending.push_back(rec);
+        }
+    }
+    queued.notify_one();
+}
+
+void EvaluationArchive::flush() {
+    std::unique_lock<std::mutex> lock{mtx};
+    drained.wait(lock, [this]() { return pending.empty() && !busy; });
+}
+
+std::size_t EvaluationArchive::written() const {
+    std::lock_guard<std::mutex> lock{mtx};
+    return count;
+}
+
+/* Private methods */
+
+void EvaluationArchive::run() {
+    std::vector<Record> batch;
+    std::vector<Record> introductions;
+    std::unique_lock<std::mutex> lock{mtx};
+    while (true) {
+        if (pending.empty()) {
+            drained.notify_all();
+            if (stopping) {
+                break;
+            }
+            queued.wait(lock);
+            continue;
+        }
+
+        // Write everything queued so far with one call
+        batch.swap(pending);
+        introductions = names();
+        busy = true;
+        lock.unlock();
+        std::size_t written = write_locked(batch, introductions);
+        lock.lock();
+        busy = false;
+
+        if (written > 0) {
+            count += written;
+        }
+        else {
+            error = true;
+        }
+        batch.clear();
+    }
+}
+
+std::size_t EvaluationArchive::write_locked(const std::vector<Record>& batch,
+                                           const std::vector<Record>& introductions) {
+    if (!lock_exclusive(fd)) {
+        return 0;
+    }
+
+    std::size_t written = 0;
+    struct stat st;
+    bool ok = fstat(fd, &st) == 0;
+    // Another process has bound the ids to its own names since
+    if (ok && st.st_size != end && !introductions.empty()) {
+        ok = write_all(fd, reinterpret_cast<const char*>(introductions.data()),
+                       introductions.size() * sizeof(Record));
+        written += introductions.size();
+    }
+    ok = ok && write_all(fd, reinterpret_cast<const char*>(batch.data()),
+                         batch.size() * sizeof(Record));
+    written += batch.size();
+    ok = ok && fstat(fd, &st) == 0;
+    if (ok) {
+        end = st.st_size;
+    }
+
+    flock(fd, LOCK_UN);
+    return ok ? written : 0;
+}
+
+std::vector<EvaluationArchive::Record> EvaluationArchive::names() const {
+    std::vector<Record> records;
+    for (const auto& id : ids) {
+        records.push_back(name_record(id.second, id.first));
+    }
+    return records;
+}
+
+EvaluationArchive::Record EvaluationArchive::name_record(std::uint16_t id,
+                                                         const std::string& benchmark) {
+    // Only the file name is kept
+    std::string name = benchmark.substr(benchmark.rfind('/') + 1);
+
+    Record rec;
+    std::memset(&rec, 0, sizeof(rec));
+    rec.name.type = NAME;
+    rec.name.benchmark = id;
+    std::strncpy(rec.name.name, name.c_str(), sizeof(rec.name.name) - 1);
+    return rec;
+}
+
+std::uint16_t EvaluationArchive::id_of(const std::string& benchmark) {
+    auto it = ids.find(benchmark);
+    if (it != ids.end()) {
+        return it->second;
+    }
+
+    std::uint16_t id = ids.size();
+    ids[benchmark] = id;
+    pending.push_back(name_record(id, benchmark));
+
+    return id;
+}
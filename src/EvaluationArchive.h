@@ -0,0 +1,176 @@
+#ifndef EVALUATION_ARCHIVE_H_
+#define EVALUATION_ARCHIVE_H_
+
+#include "Architecture.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <sys/types.h>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Append-only binary log of every benchmark run.
+ *
+ * The file starts with a Header, followed by fixed size records. A Name
+ * record maps a benchmark id to its file name and comes before the first
+ * Evaluation that uses the id. Runs can be appended to an existing archive;
+ * the ids of each run are introduced again by its own Name records.
+ *
+ * Several processes may append to one archive at the same time (e.g. the
+ * shards of a batch sharing a file). Each write holds an exclusive flock(),
+ * and starts by introducing every id of the process again if another one
+ * has written since, so that its ids are not read with the other's names.
+ *
+ * Records are formatted by the caller and written by a background thread,
+ * so adding a generation costs a copy into a queue. See ArchiveReader for
+ * reading the file back.
+ */
+class EvaluationArchive {
+public:
+    static const char MAGIC[8];
+    static const std::uint32_t VERSION;
+
+    enum RecordType : std::uint8_t {
+        NAME = 1,
+        EVALUATION = 2
+    };
+
+    struct Header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t record_size;
+    };
+
+    /* The result of running one benchmark on one architecture */
+    struct Evaluation {
+        std::uint8_t type;
+        /* Architecture::Benchmark::Status */
+        std::uint8_t status;
+        std::uint16_t benchmark;
+        std::uint32_t generation;
+        std::uint32_t K;
+        std::uint32_t N;
+        std::uint32_t W;
+        std::uint32_t route_iterations;
+        /* Peak resident set size of VPR in kB */
+        std::uint32_t peak_rss;
+        float wirelength;
+        double area;
+        double crit_path;
+        /* In seconds */
+        float pack_time;
+        float place_time;
+        float route_time;
+        float cpu_time;
+    };
+
+    /* Introduces a benchmark id */
+    struct Name {
+        std::uint8_t type;
+        std::uint8_t reserved;
+        std::uint16_t benchmark;
+        /* Null-terminated, truncated if needed */
+        char name[60];
+    };
+
+    static const std::size_t RECORD_SIZE = 64;
+
+    /* Constructors, Destructor, and Assignment operators {{{ */
+    /**
+     * Opens the archive for appending, creating it if needed.
+     * Nothing is written if the file exists but is not an archive.
+     */
+    EvaluationArchive(const std::string& path);
+
+    // Copy constructor
+    EvaluationArchive(const EvaluationArchive& other) = delete;
+
+    /**
+     * Writes whatever is still queued and closes the file.
+     */
+    ~EvaluationArchive();
+
+    // Assignment operator
+    EvaluationArchive& operator=(const EvaluationArchive& other) = delete;
+    /* }}} */
+
+    /**
+     * \return false if the file could not be opened or a write failed.
+     */
+    bool ok() const;
+
+    /**
+     * Queues a record for each benchmark of the architecture that has been
+     * run. Returns immediately.
+     *
+     * \param[in] generation the generation the architecture was evaluated in.
+     */
+    void append(unsigned generation, const Architecture& arch);
+
+    /**
+     * Blocks until everything queued so far has been written.
+     */
+    void flush();
+
+    /**
+     * \return the number of records written by this process.
+     */
+    std::size_t written() const;
+
+private:
+    /* One record of either type */
+    union Record {
+        Evaluation evaluation;
+        Name name;
+        char bytes[RECORD_SIZE];
+    };
+
+    int fd;
+
+    mutable std::mutex mtx;
+    /* Signalled when records are queued or the archive is closing */
+    std::condition_variable queued;
+    /* Signalled when the queue has been written */
+    std::condition_variable drained;
+    std::vector<Record> pending;
+    /* Benchmark file name to id in this run */
+    std::unordered_map<std::string, std::uint16_t> ids;
+    bool busy;
+    bool stopping;
+    bool error;
+    std::size_t count;
+    /* Size of the file after the last write of this process */
+    off_t end;
+    std::thread writer;
+
+    void run();
+
+    /**
+     * \return the id of the benchmark, queueing a Name record if it is new.
+     *         Must be called with mtx held.
+     */
+    std::uint16_t id_of(const std::string& benchmark);
+
+    static Record name_record(std::uint16_t id, const std::string& benchmark);
+
+    /**
+     * \return a Name record for each id of this run. Must be called with
+     *         mtx held.
+     */
+    std::vector<Record> names() const;
+
+    /**
+     * Writes the records, introducing the ids again first if the file has
+     * been written by another process since the last write.
+     *
+     * \return the number of records written, or 0 on error.
+     */
+    std::size_t write_locked(const std::vector<Record>& batch,
+                             const std::vector<Record>& introductions);
+};
+
+#endif /* end of include guard */
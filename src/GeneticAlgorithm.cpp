@@ -1,12 +1,57 @@
 #include "GeneticAlgorithm.h"
 
-std::random_device GeneticAlgorithm::rd;
-std::mt19937_64 GeneticAlgorithm::gen{rd()};
-std::uniform_real_distribution<float> GeneticAlgorithm::prob_gen{0, 1};
-
 using results_t = GeneticAlgorithm::results_t;
 using Comparator = GeneticAlgorithm::Comparator;
 using Params = GeneticAlgorithm::Params;
+using Adaptation = GeneticAlgorithm::Adaptation;
+using Objective = GeneticAlgorithm::Objective;
+using Engine = GeneticAlgorithm::Engine;
+using Strategy = Population::Strategy;
+
+const unsigned GeneticAlgorithm::DEFAULT_BASELINE_W = 100;
+
+namespace {
+
+/* What self-adaptation may do to the mutation parameters */
+const float MIN_AMOUNT = 0.001f;
+const float MAX_AMOUNT = 1.0f;
+const float MIN_RATE = 0.01f;
+/* Below 1, since the odds of a rate of 1 are stuck there */
+const float MAX_RATE = 0.99f;
+
+/* Growth on success and shrink on failure of the 1/5th success rule. Four
+ * failures undo one success, so they balance at a success rate of 1/5. */
+const double ONE_FIFTH_GROW = std::exp(1.0 / 3);
+const double ONE_FIFTH_SHRINK = std::exp(-1.0 / 12);
+
+/* Share of the candidates chosen by the surrogate for its uncertainty
+ * rather than its prediction */
+const double EXPLORE_FRACTION = 0.25;
+
+/* Job ids of the architectures run by evaluate(batch), apart from the
+ * ones of the generations and the local search */
+const std::uint64_t BATCH_JOBS = static_cast<std::uint64_t>(1) << 47;
+
+/* Learning rate of the log-normal self-adaptation, 1/sqrt(genes) */
+const double LOG_NORMAL_TAU = 1 / std::sqrt(static_cast<double>(Architecture::Genome::size));
+
+float clamp(double value, float min, float max) {
+    return static_cast<float>(std::min<double>(std::max<double>(value, min), max));
+}
+
+/* Whether an architecture has yet to be run, or was only left out for now */
+bool not_run(const Population& population, unsigned i) {
+    using Status = Architecture::Benchmark::Status;
+    for (unsigned b = 0; b < population.num_benchmarks(); b++) {
+        const Status status = population.result(i, b).status;
+        if (status == Status::SCREENED || status == Status::OUT_OF_BUDGET) {
+            return true;
+        }
+    }
+    return !population.already_run(i);
+}
+
+}
 
 /* Constructors, Destructor, and Assignment operators {{{ */
 // Default constructor
@@ -26,6 +71,20 @@ Params::Params(unsigned num_population,
     , mutation_occurrence_rate{mutation_occurrence_rate}
     , mutation_amount{mutation_amount}
     , crossover_occurrence_rate{crossover_occurrence_rate}
+    , prescreen{false}
+    , prescreen_slack{0.8}
+    , route_rule{}
+    , selection{Selection::Scheme::ROULETTE}
+    , tournament_size{2}
+    , operators{}
+    , adaptation{Adaptation::NONE}
+    , initial_sampling{Sampling::Method::RANDOM}
+    , local_search_elites{0}
+    , local_search_budget{6}
+    , objective{Objective::WEIGHTED}
+    , island{0}
+    , surrogate_pool{0}
+    , engine{Engine::GENETIC}
 { }
 
 // Copy constructor
@@ -36,6 +95,20 @@ Params::Params(const Params& other)
     , mutation_occurrence_rate{other.mutation_occurrence_rate}
     , mutation_amount{other.mutation_amount}
     , crossover_occurrence_rate{other.crossover_occurrence_rate}
+    , prescreen{other.prescreen}
+    , prescreen_slack{other.prescreen_slack}
+    , route_rule{other.route_rule}
+    , selection{other.selection}
+    , tournament_size{other.tournament_size}
+    , operators{other.operators}
+    , adaptation{other.adaptation}
+    , initial_sampling{other.initial_sampling}
+    , local_search_elites{other.local_search_elites}
+    , local_search_budget{other.local_search_budget}
+    , objective{other.objective}
+    , island{other.island}
+    , surrogate_pool{other.surrogate_pool}
+    , engine{other.engine}
 { }
 
 // Move constructor
@@ -46,6 +119,20 @@ Params::Params(Params&& other)
     , mutation_occurrence_rate{std::move(other.mutation_occurrence_rate)}
     , mutation_amount{std::move(other.mutation_amount)}
     , crossover_occurrence_rate{std::move(other.crossover_occurrence_rate)}
+    , prescreen{std::move(other.prescreen)}
+    , prescreen_slack{std::move(other.prescreen_slack)}
+    , route_rule{std::move(other.route_rule)}
+    , selection{std::move(other.selection)}
+    , tournament_size{std::move(other.tournament_size)}
+    , operators{std::move(other.operators)}
+    , adaptation{std::move(other.adaptation)}
+    , initial_sampling{std::move(other.initial_sampling)}
+    , local_search_elites{std::move(other.local_search_elites)}
+    , local_search_budget{std::move(other.local_search_budget)}
+    , objective{std::move(other.objective)}
+    , island{std::move(other.island)}
+    , surrogate_pool{std::move(other.surrogate_pool)}
+    , engine{std::move(other.engine)}
 { }
 
 // Destructor
@@ -60,6 +147,20 @@ Params& Params::operator=(const Params& other) {
     mutation_occurrence_rate = other.mutation_occurrence_rate;
     mutation_amount = other.mutation_amount;
     crossover_occurrence_rate = other.crossover_occurrence_rate;
+    prescreen = other.prescreen;
+    prescreen_slack = other.prescreen_slack;
+    route_rule = other.route_rule;
+    selection = other.selection;
+    tournament_size = other.tournament_size;
+    operators = other.operators;
+    adaptation = other.adaptation;
+    initial_sampling = other.initial_sampling;
+    local_search_elites = other.local_search_elites;
+    local_search_budget = other.local_search_budget;
+    objective = other.objective;
+    island = other.island;
+    surrogate_pool = other.surrogate_pool;
+    engine = other.engine;
     return *this;
 }
 
@@ -71,6 +172,20 @@ Params& Params::operator=(Params&& other) {
     mutation_occurrence_rate = std::move(other.mutation_occurrence_rate);
     mutation_amount = std::move(other.mutation_amount);
     crossover_occurrence_rate = std::move(other.crossover_occurrence_rate);
+    prescreen = std::move(other.prescreen);
+    prescreen_slack = std::move(other.prescreen_slack);
+    route_rule = std::move(other.route_rule);
+    selection = std::move(other.selection);
+    tournament_size = std::move(other.tournament_size);
+    operators = std::move(other.operators);
+    adaptation = std::move(other.adaptation);
+    initial_sampling = std::move(other.initial_sampling);
+    local_search_elites = std::move(other.local_search_elites);
+    local_search_budget = std::move(other.local_search_budget);
+    objective = std::move(other.objective);
+    island = std::move(other.island);
+    surrogate_pool = std::move(other.surrogate_pool);
+    engine = std::move(other.engine);
     return *this;
 }
 /* }}} */
@@ -79,73 +194,130 @@ Params& Params::operator=(Params&& other) {
 // Default constructor
 GeneticAlgorithm::GeneticAlgorithm()
     : params{}
-    , benchmarks{}
     , architectures{}
     , vtr_path{}
+    , workspace{std::make_shared<Workspace>()}
+    , reference_arch{std::make_shared<Architecture>()}
+    , baseline{}
+    , has_baseline{false}
+    , prescreened{0}
+    , archive{}
+    , termination{}
+    , known{}
+    , known_index{}
+    , local_evaluations{0}
+    , pareto{}
+    , surrogate{}
+    , predicted{}
+    , correlation{std::numeric_limits<double>::quiet_NaN()}
+    , optimizer{}
+    , generation{0}
     , selected{}
     , next_generation{}
-    , weights{}
-{ }
+    , immigrants{}
+    , scratch{}
+    , selection{}
+    , rng{Random::stream(Random::Domain::GENETIC_ALGORITHM, 0)}
+    , num_random{0}
+{
+    set_reference(reference_arch);
+}
 
 GeneticAlgorithm::GeneticAlgorithm(const Params& params, const std::string& vtr_path,
-        const std::vector<Architecture::Benchmark>& benchmarks)
+        const std::vector<Architecture::Benchmark>& benchmarks,
+        const std::shared_ptr<Workspace>& workspace)
     : params{params}
-    , benchmarks{benchmarks}
-    , architectures{params.num_population}
+    , architectures{benchmarks}
     , vtr_path{vtr_path}
+    , workspace{workspace ? workspace : std::make_shared<Workspace>()}
+    , reference_arch{std::make_shared<Architecture>()}
+    , baseline{}
+    , has_baseline{false}
+    , prescreened{0}
+    , archive{}
+    , termination{}
+    , known{architectures}
+    , known_index{}
+    , local_evaluations{0}
+    , pareto{}
+    , surrogate{}
+    , predicted{}
+    , correlation{std::numeric_limits<double>::quiet_NaN()}
+    , optimizer{}
+    , generation{0}
     , selected{}
-    , next_generation{}
-    , weights{}
+    , next_generation{architectures}
+    , immigrants{architectures}
+    , scratch{architectures}
+    , selection{params.selection, params.tournament_size,
+                params.objective == Objective::PARETO}
+    , rng{Random::stream(Random::Domain::GENETIC_ALGORITHM, stream_id(0))}
+    , num_random{0}
 {
-    fill_random_population(architectures.begin(), architectures.end());
-    for (Architecture& arch : architectures) {
-        arch.bench = benchmarks;
-    }
-
-    // Make weights for roulette selection
-    weights.resize(architectures.size());
-
-    if (weights.empty()) {
-        return;
-    }
-
-    // When weights.size() == 4
-    // |------ 0 ------|--- 1 ---|- 2 -|-3->
-    // 4               7         9     10
-    weights[0] = weights.size();
-    for (unsigned i = 1; i < weights.size(); i++) {
-        weights[i] = weights[i - 1] + weights.size() - i;
-    }
-    biased_gen = std::uniform_real_distribution<float>{
-        0, static_cast<float>(weights.back())
-    };
+    set_reference(reference_arch);
+    architectures.reserve(params.num_population);
+    next_generation.reserve(params.num_population);
+    fill_initial_population(params.num_population);
 }
 
 // Copy constructor
 GeneticAlgorithm::GeneticAlgorithm(const GeneticAlgorithm& other)
     : params{other.params}
-    , benchmarks{other.benchmarks}
     , architectures{other.architectures}
     , vtr_path{other.vtr_path}
+    , workspace{other.workspace}
+    , reference_arch{other.reference_arch}
+    , baseline(other.baseline)
+    , has_baseline{other.has_baseline}
+    , prescreened{other.prescreened}
+    , archive{other.archive}
+    , termination{other.termination}
+    , known{other.known}
+    , known_index{other.known_index}
+    , local_evaluations{other.local_evaluations}
+    , pareto{other.pareto}
+    , surrogate{other.surrogate}
+    , predicted{other.predicted}
+    , correlation{other.correlation}
+    , optimizer{other.optimizer}
+    , generation{other.generation}
     , selected{other.selected}
     , next_generation{other.next_generation}
-    , weights{other.weights}
-{
-    biased_gen = std::uniform_real_distribution<float>{
-        0, static_cast<float>(weights.back())
-    };
-}
+    , immigrants{other.immigrants}
+    , scratch{other.scratch}
+    , selection{other.selection}
+    , rng{other.rng}
+    , num_random{other.num_random}
+{ }
 
 // Move constructor
 GeneticAlgorithm::GeneticAlgorithm(GeneticAlgorithm&& other)
     : params{std::move(other.params)}
-    , benchmarks{std::move(other.benchmarks)}
     , architectures{std::move(other.architectures)}
     , vtr_path{std::move(other.vtr_path)}
+    , workspace{std::move(other.workspace)}
+    , reference_arch{std::move(other.reference_arch)}
+    , baseline(std::move(other.baseline))
+    , has_baseline{other.has_baseline}
+    , prescreened{std::move(other.prescreened)}
+    , archive{std::move(other.archive)}
+    , termination{std::move(other.termination)}
+    , known{std::move(other.known)}
+    , known_index{std::move(other.known_index)}
+    , local_evaluations{other.local_evaluations}
+    , pareto{std::move(other.pareto)}
+    , surrogate{std::move(other.surrogate)}
+    , predicted{std::move(other.predicted)}
+    , correlation{other.correlation}
+    , optimizer{std::move(other.optimizer)}
+    , generation{std::move(other.generation)}
     , selected{std::move(other.selected)}
     , next_generation{std::move(other.next_generation)}
-    , weights{std::move(other.weights)}
-    , biased_gen{std::move(other.biased_gen)}
+    , immigrants{std::move(other.immigrants)}
+    , scratch{std::move(other.scratch)}
+    , selection{std::move(other.selection)}
+    , rng{std::move(other.rng)}
+    , num_random{other.num_random}
 { }
 
 // Destructor
@@ -155,82 +327,217 @@ GeneticAlgorithm::~GeneticAlgorithm()
 // Assignment operator
 GeneticAlgorithm& GeneticAlgorithm::operator=(const GeneticAlgorithm& other) {
     params = other.params;
-    benchmarks = other.benchmarks;
     architectures = other.architectures;
     next_generation = other.next_generation;
+    immigrants = other.immigrants;
+    scratch = other.scratch;
     vtr_path = other.vtr_path;
+    workspace = other.workspace;
+    reference_arch = other.reference_arch;
+    baseline = other.baseline;
+    has_baseline = other.has_baseline;
+    prescreened = other.prescreened;
+    archive = other.archive;
+    termination = other.termination;
+    known = other.known;
+    known_index = other.known_index;
+    local_evaluations = other.local_evaluations;
+    pareto = other.pareto;
+    surrogate = other.surrogate;
+    predicted = other.predicted;
+    correlation = other.correlation;
+    optimizer = other.optimizer;
+    generation = other.generation;
     selected = other.selected;
-    weights = other.weights;
-    biased_gen = std::uniform_real_distribution<float>{
-        0, static_cast<float>(weights.back())
-    };
+    selection = other.selection;
+    rng = other.rng;
+    num_random = other.num_random;
     return *this;
 }
 
 // Move assignment operator
 GeneticAlgorithm& GeneticAlgorithm::operator=(GeneticAlgorithm&& other) {
     params = std::move(other.params);
-    benchmarks = std::move(other.benchmarks);
     architectures = std::move(other.architectures);
     next_generation = std::move(other.next_generation);
+    immigrants = std::move(other.immigrants);
+    scratch = std::move(other.scratch);
     vtr_path = std::move(other.vtr_path);
+    workspace = std::move(other.workspace);
+    reference_arch = std::move(other.reference_arch);
+    baseline = std::move(other.baseline);
+    has_baseline = other.has_baseline;
+    prescreened = std::move(other.prescreened);
+    archive = std::move(other.archive);
+    termination = std::move(other.termination);
+    known = std::move(other.known);
+    known_index = std::move(other.known_index);
+    local_evaluations = other.local_evaluations;
+    pareto = std::move(other.pareto);
+    surrogate = std::move(other.surrogate);
+    predicted = std::move(other.predicted);
+    correlation = other.correlation;
+    optimizer = std::move(other.optimizer);
+    generation = std::move(other.generation);
     selected = std::move(other.selected);
-    weights = std::move(other.weights);
-    biased_gen = std::move(other.biased_gen);
+    selection = std::move(other.selection);
+    rng = std::move(other.rng);
+    num_random = other.num_random;
     return *this;
 }
 /* }}} */
 
 void GeneticAlgorithm::run_generation() {
-    if (!next_generation.empty()) {
+    begin_generation();
+    evaluate();
+    end_generation();
+}
+
+void GeneticAlgorithm::begin_generation() {
+    if (generation > 0) {
         change_generation();
-        next_generation.clear();
     }
     selected.clear();
+}
 
-    evaluate();
+void GeneticAlgorithm::end_generation() {
+    if (params.adaptation == Adaptation::ONE_FIFTH) {
+        adapt();
+    }
 
     // Throw away all failed architectures
-    auto new_end = std::remove_if(architectures.begin(),
-                                  architectures.end(),
-                                  [] (const Architecture& a) {
-                                  return !a.non_failed();
-                                  });
-    architectures.resize(std::distance(architectures.begin(), new_end));
+    architectures.remove_failed();
+    if (architectures.empty()) {
+        // Start over with random ones
+        generation++;
+        return;
+    }
 
-    unsigned lim = std::min(params.elites_preserve,
-                            static_cast<unsigned>(architectures.size()));
+    unsigned lim = std::min(params.elites_preserve, architectures.size());
 
-    // Use best of the first generation as reference point
-    for (unsigned i = 0; i < get_best().bench.size(); i++) {
-        // Save as reference values
-        if (!Architecture::reference_results[i].is_populated) {
-            Architecture::reference_results[i] = get_best().bench[i];
-            Architecture::reference_results[i].is_populated = true;
+    // Measure against the baseline if it did not fail, otherwise against
+    // the first architecture of the first generation that did not
+    if (reference_arch->bench.empty() && !architectures.empty()) {
+        unsigned from = 0;
+        for (unsigned i = 0; has_baseline && i < architectures.size(); i++) {
+            if (Architecture::Genome::equal(architectures.genome(i), baseline)) {
+                from = i;
+                break;
+            }
         }
+        *reference_arch = architectures.to_architecture(from);
+    }
+
+    // Copy the elites. Tournaments do not need the rest in order.
+    const unsigned ranked = selection.needs_ranking() ? architectures.size()
+        : std::max(lim, params.local_search_elites);
+    sort_population(ranked);
+    if (params.local_search_elites > 0 && local_search()) {
+        sort_population(ranked);
+    }
+    if (params.objective == Objective::PARETO) {
+        pareto.update(architectures);
+    }
+    if (params.surrogate_pool > 0) {
+        train_surrogate();
+    }
+    for (unsigned i = 0; i < lim; i++) {
+        next_generation.add(architectures, i);
     }
 
-    // Copy the elites
-    sort_population();
-    std::copy(architectures.begin(),
-              architectures.begin() + lim,
-              std::back_inserter(next_generation));
+    if (params.engine == Engine::BAYESIAN) {
+        // One batch for the rest of the next generation
+        for (unsigned i = 0; i < architectures.size(); i++) {
+            optimizer.add(architectures.genome(i), architectures.fitness(i));
+        }
+        const unsigned batch = params.num_population
+            - std::min(params.num_population, next_generation.size());
+        for (const auto& genome : optimizer.propose(batch, rng)) {
+            next_generation.add(genome, initial_strategy());
+        }
+        generation++;
+        return;
+    }
 
     // Prepare for the next generation (but not replace yet)
     select();
     crossover();
     mutate();
+    if (params.surrogate_pool > 0 && surrogate.ready()) {
+        screen_offspring();
+    }
+
+    generation++;
+}
+
+void GeneticAlgorithm::warm_start(const Population& results,
+                                  const std::vector<unsigned>& seeds) {
+    if (generation > 0) {
+        throw std::logic_error{"Cannot warm start after the first generation"};
+    }
+
+    architectures.clear();
+    for (unsigned i : seeds) {
+        if (architectures.size() == params.num_population) {
+            break;
+        }
+        unsigned j = architectures.add(results, i);
+        architectures.strategy(j) = initial_strategy();
+        if (params.local_search_elites > 0) {
+            remember(architectures, j);
+        }
+    }
+    // A design of its own for the rest, so it stays spread out
+    fill_initial_population(params.num_population - architectures.size());
+}
+
+void GeneticAlgorithm::set_reference(const std::shared_ptr<Architecture>& reference) {
+    reference_arch = reference;
+    for (Population* population : {&architectures, &known, &next_generation,
+                                   &immigrants, &scratch}) {
+        population->set_reference(reference);
+    }
 }
 
-const Architecture& GeneticAlgorithm::get_best() const {
-    return architectures.front();
+const Architecture& GeneticAlgorithm::reference() const {
+    return *reference_arch;
 }
 
-const Architecture& GeneticAlgorithm::get_worst() const {
-    return architectures.back();
+void GeneticAlgorithm::set_baseline(const Architecture::Genome::Values& genome) {
+    if (generation > 0) {
+        throw std::logic_error{"Cannot add a baseline after the first generation"};
+    }
+    baseline = genome;
+    has_baseline = true;
 }
 
-const std::vector<Architecture>& GeneticAlgorithm::population() const {
+Architecture::Genome::Values GeneticAlgorithm::parse_baseline(const std::string& name) {
+    Architecture::Genome::Values genome;
+    unsigned K, N, W = DEFAULT_BASELINE_W;
+    char rest;
+    if (std::sscanf(name.c_str(), "%u,%u,%u%c", &K, &N, &W, &rest) != 3
+        && std::sscanf(name.c_str(), "k%u_N%u_W%u%c", &K, &N, &W, &rest) != 3
+        && std::sscanf(name.c_str(), "k%u_N%u%c", &K, &N, &rest) != 2) {
+        throw std::invalid_argument{"Unknown baseline " + name};
+    }
+    genome[Architecture::GENE_K] = K;
+    genome[Architecture::GENE_N] = N;
+    genome[Architecture::GENE_W] = W;
+    if (!Architecture::Genome::valid(genome)) {
+        throw std::invalid_argument{"Baseline " + name + " is out of range"};
+    }
+    return genome;
+}
+
+Architecture GeneticAlgorithm::get_best() const {
+    return architectures.to_architecture(0);
+}
+
+Architecture GeneticAlgorithm::get_worst() const {
+    return architectures.to_architecture(architectures.size() - 1);
+}
+
+const Population& GeneticAlgorithm::population() const {
     return architectures;
 }
 
@@ -238,148 +545,668 @@ const Params& GeneticAlgorithm::parameters() const {
     return params;
 }
 
+Adaptation GeneticAlgorithm::parse_adaptation(const std::string& name) {
+    if (name == "none") {
+        return Adaptation::NONE;
+    }
+    if (name == "one-fifth") {
+        return Adaptation::ONE_FIFTH;
+    }
+    if (name == "log-normal") {
+        return Adaptation::LOG_NORMAL;
+    }
+    throw std::invalid_argument{"Unknown mutation adaptation " + name};
+}
+
+Engine GeneticAlgorithm::parse_engine(const std::string& name) {
+    if (name == "genetic") {
+        return Engine::GENETIC;
+    }
+    if (name == "bayesian") {
+        return Engine::BAYESIAN;
+    }
+    throw std::invalid_argument{"Unknown engine " + name};
+}
+
+Objective GeneticAlgorithm::parse_objective(const std::string& name) {
+    if (name == "weighted") {
+        return Objective::WEIGHTED;
+    }
+    if (name == "pareto") {
+        return Objective::PARETO;
+    }
+    throw std::invalid_argument{"Unknown objective " + name};
+}
+
+const ParetoArchive& GeneticAlgorithm::pareto_front() const {
+    return pareto;
+}
+
+Strategy GeneticAlgorithm::mutation_strategy() const {
+    if (params.adaptation == Adaptation::NONE || architectures.empty()) {
+        return initial_strategy();
+    }
+
+    double amount = 0, rate = 0;
+    for (unsigned i = 0; i < architectures.size(); i++) {
+        amount += architectures.strategy(i).mutation_amount;
+        rate += architectures.strategy(i).mutation_occurrence_rate;
+    }
+    return Strategy(amount / architectures.size(), rate / architectures.size());
+}
+
+unsigned GeneticAlgorithm::num_prescreened() const {
+    return prescreened;
+}
+
+unsigned GeneticAlgorithm::num_local_evaluations() const {
+    return local_evaluations;
+}
+
+double GeneticAlgorithm::surrogate_correlation() const {
+    return correlation;
+}
+
+unsigned GeneticAlgorithm::num_generations() const {
+    return generation;
+}
+
+void GeneticAlgorithm::set_archive(const std::shared_ptr<EvaluationArchive>& archive) {
+    this->archive = archive;
+}
+
+void GeneticAlgorithm::set_termination(const std::shared_ptr<Termination>& termination) {
+    this->termination = termination;
+}
+
 void GeneticAlgorithm::evaluate() {
+    std::vector<unsigned> fresh = begin_evaluation();
 #pragma omp parallel for schedule(dynamic)
+    for (unsigned j = 0; j < fresh.size(); j++) {
+        evaluate_one(fresh[j]);
+    }
+    end_evaluation(fresh);
+}
+
+std::vector<unsigned> GeneticAlgorithm::begin_evaluation() {
+    // The baseline goes with the first generation that is run
+    if (has_baseline && reference_arch->bench.empty()) {
+        bool found = false;
+        for (unsigned i = 0; i < architectures.size() && !found; i++) {
+            found = Architecture::Genome::equal(architectures.genome(i), baseline);
+        }
+        if (!found) {
+            architectures.add(baseline, initial_strategy());
+        }
+    }
+
+    // Including the ones that are about to be screened out
+    std::vector<unsigned> fresh;
     for (unsigned i = 0; i < architectures.size(); i++) {
-        if (!architectures[i].already_run()) {
-            std::string file_name = architectures[i].make_arch_file();
-            // Populate the Architecture::Benchmark for each architecture
-            architectures[i].run_benchmarks(vtr_path);
-            std::remove(file_name.c_str());
+        if (!architectures.already_run(i)) {
+            fresh.push_back(i);
         }
     }
+
+    if (params.prescreen) {
+        prescreen();
+    }
+    return fresh;
 }
 
-void GeneticAlgorithm::select() {
-    // However many architectures that have successful results
-    unsigned successes = std::count_if(architectures.begin(),
-                                       architectures.end(),
-                                       [] (const Architecture& a) {
-                                       return a.non_failed();
-                                       });
-    unsigned lim = std::min(params.num_selection, successes);
-    // Select what to crossever/mutate from
-    unsigned cnt = 0;
-    while (cnt < lim) {
-        unsigned index;
-        do {
-            index = get_biased_index();
-        } while (index >= architectures.size());
+void GeneticAlgorithm::evaluate_one(unsigned i) {
+    if (!architectures.already_run(i)) {
+        run(architectures, i,
+            stream_id((static_cast<std::uint64_t>(generation) << 32) | i));
+    }
+}
+
+void GeneticAlgorithm::end_evaluation(const std::vector<unsigned>& fresh) {
+    // Written out by the archive's own thread
+    if (archive) {
+        for (unsigned i : fresh) {
+            archive->append(generation, architectures.to_architecture(i));
+        }
+    }
 
-        const Architecture& arch = architectures[index];
+    if (params.local_search_elites > 0) {
+        for (unsigned i : fresh) {
+            remember(architectures, i);
+        }
+    }
 
-        // Same architecture shouldn't be selected more than once
-        if (arch.non_failed() && std::count(selected.begin(),
-                                            selected.end(),
-                                            arch) == 0) {
-            selected.push_back(arch);
-            cnt++;
+    // Failed ones are not proposed again either
+    if (params.engine == Engine::BAYESIAN) {
+        for (unsigned i : fresh) {
+            if (!not_run(architectures, i)) {
+                optimizer.exclude(architectures.genome(i));
+            }
         }
     }
 }
 
+void GeneticAlgorithm::evaluate(Population& batch,
+                                const std::vector<std::uint64_t>& jobs,
+                                const std::function<void(unsigned)>& done) {
+#pragma omp parallel for schedule(dynamic)
+    for (unsigned i = 0; i < batch.size(); i++) {
+        if (!batch.already_run(i)) {
+            run(batch, i, stream_id(BATCH_JOBS | jobs[i]));
+        }
+#pragma omp critical(batch_done)
+        {
+            if (archive) {
+                archive->append(generation, batch.to_architecture(i));
+            }
+            done(i);
+        }
+    }
+}
+
+void GeneticAlgorithm::select() {
+    // Failed architectures have been thrown away already
+    selected = selection.select(architectures, params.num_selection, rng);
+}
+
 void GeneticAlgorithm::crossover() {
+    // Needs two different parents
+    if (selected.size() < 2) {
+        return;
+    }
+
     if (trigger(params.crossover_occurrence_rate)) {
-        Architecture a, b;
+        unsigned a, b;
         std::tie(a, b) = get_two_random(selected);
-        Architecture child1{benchmarks};
-        Architecture child2{benchmarks};
-
-        std::tie(child1.K, child2.K) = crossover_helper(a.K, b.K);
-        std::tie(child1.N, child2.N) = crossover_helper(a.N, b.N);
-        std::tie(child1.W, child2.W) = crossover_helper(a.W, b.W);
-        // Routing channel width must be even for unidirectional
-        child1.W = child1.W % 2 == 0 ? child1.W : child1.W + 1;
-        child2.W = child2.W % 2 == 0 ? child2.W : child2.W + 1;
-
-        next_generation.push_back(std::move(child1));
-        next_generation.push_back(std::move(child2));
+        auto children = Architecture::Genome::crossover(architectures.genome(a),
+                                                        architectures.genome(b),
+                                                        rng, params.operators);
+        // The children start from the average of their parents
+        Strategy strategy = initial_strategy();
+        if (params.adaptation != Adaptation::NONE) {
+            const Strategy& sa = architectures.strategy(a);
+            const Strategy& sb = architectures.strategy(b);
+            strategy.mutation_amount = (sa.mutation_amount + sb.mutation_amount) / 2;
+            strategy.mutation_occurrence_rate =
+                (sa.mutation_occurrence_rate + sb.mutation_occurrence_rate) / 2;
+        }
+        next_generation.add(children.first, strategy);
+        next_generation.add(children.second, strategy);
     }
 }
 
 void GeneticAlgorithm::mutate() {
-    for (const Architecture& arch : selected) {
-        if (trigger(params.mutation_occurrence_rate)) {
-            Architecture mutant{arch};
-            mutant.mutate(params.mutation_amount);
-            mutant.bench = benchmarks;
+    for (unsigned i : selected) {
+        Strategy strategy = initial_strategy();
+        if (params.adaptation != Adaptation::NONE) {
+            strategy = architectures.strategy(i);
+            strategy.parent_fitness = -1;
+        }
+        if (params.adaptation == Adaptation::LOG_NORMAL) {
+            // The child's own parameters decide how it is made
+            strategy = log_normal_step(strategy, rng);
+        }
+
+        if (trigger(strategy.mutation_occurrence_rate)) {
+            // Only the genome, no benchmarks to copy
+            Architecture::Genome::Values mutant = architectures.genome(i);
+            Architecture::Genome::mutate(mutant, strategy.mutation_amount, rng,
+                                         params.operators);
+            if (params.adaptation == Adaptation::ONE_FIFTH) {
+                strategy.parent_fitness = architectures.fitness(i);
+            }
+            next_generation.add(mutant, strategy);
+        }
+    }
+}
 
-            next_generation.push_back(std::move(mutant));
+std::vector<unsigned> GeneticAlgorithm::best(unsigned count) const {
+    // Each fitness goes over all benchmarks, so compute it only once.
+    // Already in order by front and crowding in the PARETO mode.
+    std::vector<std::pair<double, unsigned>> keys;
+    for (unsigned i = 0; i < architectures.size(); i++) {
+        if (architectures.already_run(i) && architectures.non_failed(i)) {
+            keys.emplace_back(params.objective == Objective::WEIGHTED
+                              ? architectures.fitness(i) : 0, i);
         }
     }
+    count = std::min<unsigned>(count, keys.size());
+    std::partial_sort(keys.begin(), keys.begin() + count, keys.end());
+
+    std::vector<unsigned> order(count);
+    for (unsigned i = 0; i < count; i++) {
+        order[i] = keys[i].second;
+    }
+    return order;
+}
+
+void GeneticAlgorithm::immigrate(const Population& from, unsigned i) {
+    unsigned j = immigrants.add(from, i);
+    immigrants.strategy(j).parent_fitness = -1;
 }
 
 void GeneticAlgorithm::change_generation() {
     const unsigned num_pop = params.num_population;
-    if (next_generation.size() > num_pop) {
-        // Throw away any excessive entities
-        next_generation.resize(num_pop);
+    // Throw away any excessive entities, and make room for the immigrants
+    // in place of the last children
+    const unsigned arriving = std::min(immigrants.size(), num_pop);
+    next_generation.truncate(num_pop - arriving);
+    for (unsigned i = 0; i < arriving; i++) {
+        next_generation.add(immigrants, i);
     }
+    immigrants.clear();
 
     // If there's not enough population, randomly generate some
-    unsigned lim = num_pop - next_generation.size();
-    for (unsigned i = 0; i < lim; i++) {
-        next_generation.push_back(Architecture::random(benchmarks));
-    }
+    fill_random_population(next_generation, num_pop);
 
-    architectures = next_generation;
+    // The old generation's memory is reused for the one after
+    architectures.swap(next_generation);
+    next_generation.clear();
 }
 
 /* Private methods */
 
-template<typename ForwardIter>
-void GeneticAlgorithm::fill_random_population(const ForwardIter& begin,
-                                              const ForwardIter& end) {
-    std::generate(begin, end, [this](){
-                  return Architecture::random(benchmarks);
-                  });
+std::uint64_t GeneticAlgorithm::stream_id(std::uint64_t id) const {
+    // Up to 2^48 ids per island
+    return (static_cast<std::uint64_t>(params.island) << 48) | id;
+}
+
+void GeneticAlgorithm::run(Population& population, unsigned i,
+                           std::uint64_t job) {
+    // Would not finish in time
+    if (termination && !termination->start_evaluation()) {
+        population.set_failed(i, Architecture::Benchmark::Status::OUT_OF_BUDGET);
+        return;
+    }
+    auto started = std::chrono::steady_clock::now();
+
+    Architecture arch = population.to_architecture(i);
+    // The directory with the architecture file is reclaimed by the
+    // workspace once the benchmarks have been run
+    arch.make_arch_file(*workspace);
+    // Populate the Architecture::Benchmark for each architecture
+    arch.run_benchmarks(vtr_path, *workspace, params.route_rule, job);
+    population.store(i, arch);
+
+    if (termination) {
+        std::chrono::duration<double> took = std::chrono::steady_clock::now()
+            - started;
+        termination->finished(took.count(), arch.total_stats().cpu_time);
+    }
+}
+
+void GeneticAlgorithm::remember(const Population& population, unsigned i) {
+    if (not_run(population, i)) {
+        return;
+    }
+    const std::uint64_t key = Architecture::Genome::key(population.genome(i));
+    if (known_index.count(key) == 0) {
+        known_index[key] = known.add(population, i);
+    }
+}
+
+bool GeneticAlgorithm::local_search() {
+    const unsigned elites = std::min(params.local_search_elites,
+                                     architectures.size());
+    unsigned budget = params.local_search_budget;
+    bool improved = false;
+    // Elites may descend to the same optimum, or onto one another
+    std::unordered_set<std::uint64_t> present;
+    for (unsigned i = 0; i < architectures.size(); i++) {
+        present.insert(Architecture::Genome::key(architectures.genome(i)));
+    }
+
+    for (unsigned e = 0; e < elites; e++) {
+        Architecture::Genome::Values current = architectures.genome(e);
+        double fitness = architectures.fitness(e);
+        unsigned best = UINT_MAX;
+
+        // Steepest descent, which stops since the fitness keeps going down
+        while (true) {
+            unsigned next = UINT_MAX;
+            for (unsigned j : run_neighbours(current, budget)) {
+                if (known.non_failed(j) && known.fitness(j) < fitness) {
+                    next = j;
+                    fitness = known.fitness(j);
+                }
+            }
+            if (next == UINT_MAX) {
+                break;
+            }
+            best = next;
+            current = known.genome(next);
+        }
+
+        if (best != UINT_MAX
+            && present.insert(Architecture::Genome::key(known.genome(best))).second) {
+            // Carries on with the mutation parameters of the elite
+            Strategy strategy = architectures.strategy(e);
+            strategy.parent_fitness = -1;
+            unsigned i = architectures.add(known, best);
+            architectures.strategy(i) = strategy;
+            improved = true;
+        }
+    }
+    return improved;
+}
+
+std::vector<unsigned> GeneticAlgorithm::run_neighbours(
+        const Architecture::Genome::Values& genome, unsigned& budget) {
+    std::vector<unsigned> rows;
+    std::vector<unsigned> fresh;
+    for (const auto& neighbour : Architecture::Genome::neighbours(genome)) {
+        auto found = known_index.find(Architecture::Genome::key(neighbour));
+        if (found != known_index.end()) {
+            rows.push_back(found->second);
+        }
+        else if (budget > 0) {
+            budget--;
+            fresh.push_back(known.add(neighbour, initial_strategy()));
+        }
+    }
+
+    // Numbered after the jobs of the population, which stay below 2^31
+    const std::uint64_t first = stream_id((static_cast<std::uint64_t>(generation) << 32)
+                                          | (static_cast<std::uint64_t>(1) << 31));
+#pragma omp parallel for schedule(dynamic)
+    for (unsigned j = 0; j < fresh.size(); j++) {
+        run(known, fresh[j], first | ((local_evaluations + j) & INT_MAX));
+    }
+    local_evaluations += fresh.size();
+
+    for (unsigned i : fresh) {
+        if (archive) {
+            archive->append(generation, known.to_architecture(i));
+        }
+        // Rows that were not run stay out of the index
+        if (!not_run(known, i)) {
+            known_index[Architecture::Genome::key(known.genome(i))] = i;
+            rows.push_back(i);
+        }
+    }
+    return rows;
+}
+
+void GeneticAlgorithm::train_surrogate() {
+    std::vector<double> expected, actual;
+    for (unsigned i = 0; i < architectures.size(); i++) {
+        const auto genome = architectures.genome(i);
+        const double fitness = architectures.fitness(i);
+        // Failed ones are gone, so they are not compared
+        auto found = predicted.find(Architecture::Genome::key(genome));
+        if (found != predicted.end()) {
+            expected.push_back(found->second);
+            actual.push_back(fitness);
+        }
+        surrogate.add(genome, fitness);
+    }
+    predicted.clear();
+    correlation = Surrogate::rank_correlation(expected, actual);
+}
+
+void GeneticAlgorithm::screen_offspring() {
+    using Genome = Architecture::Genome;
+    const unsigned elites = std::min(params.elites_preserve, architectures.size());
+    if (params.num_population <= elites) {
+        return;
+    }
+    const unsigned slots = params.num_population - elites;
+
+    // The children made so far, then more of the same kind
+    std::vector<unsigned> children(next_generation.size() - elites);
+    std::iota(children.begin(), children.end(), elites);
+    Population pool;
+    pool.gather(next_generation, children);
+    for (unsigned tries = 0; pool.size() < params.surrogate_pool
+         && tries < 4 * params.surrogate_pool; tries++) {
+        Strategy strategy = initial_strategy();
+        Genome::Values genome;
+        if (selected.size() >= 2 && trigger(0.5)) {
+            unsigned a, b;
+            std::tie(a, b) = get_two_random(selected);
+            genome = Genome::crossover(architectures.genome(a),
+                                       architectures.genome(b),
+                                       rng, params.operators).first;
+        }
+        else if (!selected.empty()) {
+            const unsigned a = selected[rng() % selected.size()];
+            if (params.adaptation != Adaptation::NONE) {
+                strategy = architectures.strategy(a);
+                strategy.parent_fitness = -1;
+            }
+            if (params.adaptation == Adaptation::ONE_FIFTH) {
+                strategy.parent_fitness = architectures.fitness(a);
+            }
+            genome = architectures.genome(a);
+            Genome::mutate(genome, strategy.mutation_amount, rng,
+                           params.operators);
+        }
+        else {
+            genome = Genome::random(rng);
+        }
+        pool.add(genome, strategy);
+    }
+
+    // Nothing that has been run or is there already
+    std::unordered_set<std::uint64_t> seen;
+    for (unsigned i = 0; i < elites; i++) {
+        seen.insert(Genome::key(next_generation.genome(i)));
+    }
+    std::vector<std::pair<Surrogate::Prediction, unsigned>> candidates;
+    for (unsigned i = 0; i < pool.size(); i++) {
+        const Genome::Values genome = pool.genome(i);
+        if (surrogate.contains(genome) || !seen.insert(Genome::key(genome)).second) {
+            continue;
+        }
+        candidates.emplace_back(surrogate.predict(genome), i);
+    }
+
+    // The best predictions, then the least certain of the others
+    const unsigned explore = std::min<unsigned>(slots * EXPLORE_FRACTION,
+                                                candidates.size());
+    const unsigned exploit = std::min<unsigned>(slots, candidates.size()) - explore;
+    std::sort(candidates.begin(), candidates.end(),
+              [](const std::pair<Surrogate::Prediction, unsigned>& a,
+                 const std::pair<Surrogate::Prediction, unsigned>& b) {
+        return a.first.fitness != b.first.fitness
+            ? a.first.fitness < b.first.fitness : a.second < b.second;
+    });
+    std::sort(candidates.begin() + exploit, candidates.end(),
+              [](const std::pair<Surrogate::Prediction, unsigned>& a,
+                 const std::pair<Surrogate::Prediction, unsigned>& b) {
+        return a.first.uncertainty != b.first.uncertainty
+            ? a.first.uncertainty > b.first.uncertainty : a.second < b.second;
+    });
+
+    next_generation.truncate(elites);
+    for (unsigned j = 0; j < exploit + explore; j++) {
+        const unsigned i = candidates[j].second;
+        next_generation.add(pool, i);
+        predicted[Genome::key(pool.genome(i))] = candidates[j].first.fitness;
+    }
+}
+
+void GeneticAlgorithm::prescreen() {
+    // Nothing to compare against before the reference is set
+    if (reference_arch->bench.empty()) {
+        return;
+    }
+
+    // The worst of the architectures that are carried over, or all of them
+    // in the PARETO mode
+    bool has_survivor = false;
+    double threshold = 0;
+    std::vector<ParetoArchive::Objectives> survivors;
+    for (unsigned i = 0; i < architectures.size(); i++) {
+        if (architectures.already_run(i) && architectures.non_failed(i)) {
+            double fitness = architectures.fitness(i);
+            threshold = has_survivor ? std::max(threshold, fitness) : fitness;
+            has_survivor = true;
+            survivors.push_back(ParetoArchive::objectives(architectures, i));
+        }
+    }
+
+    if (!has_survivor) {
+        return;
+    }
+
+    Architecture arch;
+    for (unsigned i = 0; i < architectures.size(); i++) {
+        if (architectures.already_run(i)) {
+            continue;
+        }
+
+        arch.K = architectures.K(i);
+        arch.N = architectures.N(i);
+        arch.W = architectures.W(i);
+        bool screened;
+        if (params.objective == Objective::PARETO) {
+            // Very good in one objective is enough to reach the front
+            auto estimate = AnalyticModel::ratio_estimate(arch, *reference_arch,
+                                                          params.prescreen_slack);
+            const ParetoArchive::Objectives point{estimate.second, estimate.first};
+            screened = std::all_of(survivors.begin(), survivors.end(),
+                                   [&point](const ParetoArchive::Objectives& s) {
+                return ParetoArchive::dominates(s, point);
+            });
+        }
+        else {
+            screened = AnalyticModel::fitness_estimate(arch, *reference_arch,
+                                                       params.prescreen_slack)
+                > threshold;
+        }
+        if (screened) {
+            architectures.set_failed(i, Architecture::Benchmark::Status::SCREENED);
+            prescreened++;
+        }
+    }
+}
+
+void GeneticAlgorithm::fill_random_population(Population& population,
+                                              unsigned size) {
+    while (population.size() < size) {
+        Philox individual = Random::stream(Random::Domain::INDIVIDUAL,
+                                           stream_id(num_random++));
+        population.add(Architecture::Genome::random(individual),
+                       initial_strategy());
+    }
+}
+
+void GeneticAlgorithm::fill_initial_population(unsigned count) {
+    if (params.initial_sampling == Sampling::Method::RANDOM) {
+        fill_random_population(architectures, architectures.size() + count);
+        return;
+    }
+
+    // The whole design comes from one stream, so the seed reproduces it
+    Philox design = Random::stream(Random::Domain::SAMPLING, stream_id(0));
+    auto points = Sampling::unit_points(params.initial_sampling,
+                                        count,
+                                        Architecture::Genome::size,
+                                        design);
+    for (const std::vector<double>& point : points) {
+        architectures.add(Architecture::Genome::from_unit(point),
+                          initial_strategy());
+    }
+}
+
+Strategy GeneticAlgorithm::initial_strategy() const {
+    return Strategy(params.mutation_amount, params.mutation_occurrence_rate);
+}
+
+void GeneticAlgorithm::adapt() {
+    for (unsigned i = 0; i < architectures.size(); i++) {
+        Strategy& strategy = architectures.strategy(i);
+        if (strategy.parent_fitness < 0 || !architectures.already_run(i)) {
+            continue;
+        }
+
+        const bool success = architectures.non_failed(i)
+            && architectures.fitness(i) < strategy.parent_fitness;
+        strategy = one_fifth_step(strategy, success);
+        strategy.parent_fitness = -1;
+    }
+}
+
+Strategy GeneticAlgorithm::one_fifth_step(const Strategy& strategy, bool success) {
+    const double factor = success ? ONE_FIFTH_GROW : ONE_FIFTH_SHRINK;
+    Strategy next = strategy;
+    next.mutation_amount = clamp(strategy.mutation_amount * factor,
+                                 MIN_AMOUNT, MAX_AMOUNT);
+    next.mutation_occurrence_rate = clamp(strategy.mutation_occurrence_rate * factor,
+                                          MIN_RATE, MAX_RATE);
+    return next;
+}
+
+Strategy GeneticAlgorithm::log_normal_step(const Strategy& strategy, Philox& rng) {
+    std::normal_distribution<double> step{0, LOG_NORMAL_TAU};
+    Strategy next = strategy;
+    next.mutation_amount = clamp(strategy.mutation_amount * std::exp(step(rng)),
+                                 MIN_AMOUNT, MAX_AMOUNT);
+    // Log-normal on the odds, which keeps the rate in (0, 1)
+    const double rate = strategy.mutation_occurrence_rate;
+    next.mutation_occurrence_rate = clamp(
+        1 / (1 + (1 - rate) / rate * std::exp(-step(rng))),
+        MIN_RATE, MAX_RATE);
+    return next;
 }
 
 bool GeneticAlgorithm::trigger(const float probability) {
-    return prob_gen(gen) <= probability;
+    std::uniform_real_distribution<float> prob_gen{0, 1};
+    return prob_gen(rng) <= probability;
 }
 
 template<typename T>
 std::pair<T, T> GeneticAlgorithm::get_two_random(const std::vector<T>& vec) {
-    unsigned a = gen() % vec.size();
+    unsigned a = rng() % vec.size();
     unsigned b;
     do {
-        b = gen() % vec.size();
+        b = rng() % vec.size();
     } while (a == b);
 
     return std::make_pair(vec[a], vec[b]);
 }
 
-unsigned GeneticAlgorithm::get_biased_index(const unsigned offset) {
-    float rnd_number = biased_gen(gen);
-    for (unsigned i = 0; i < weights.size(); i++) {
-        if (weights[i] > rnd_number) {
-            return offset + i;
+void GeneticAlgorithm::sort_population(unsigned ranked) {
+    const unsigned size = architectures.size();
+    if (size < 2) {
+        return;
+    }
+    ranked = std::min(ranked, size);
+
+    if (params.objective == Objective::PARETO) {
+        // The fronts take a full sort to find anyway
+        std::vector<ParetoArchive::Objectives> points(size);
+        for (unsigned i = 0; i < size; i++) {
+            points[i] = ParetoArchive::objectives(architectures, i);
         }
+        scratch.gather(architectures, ParetoArchive::crowded_order(points));
+        architectures.swap(scratch);
+        return;
     }
 
-    return offset + weights.size() - 1;
-}
+    // Each fitness goes over all benchmarks, so compute it only once.
+    // The index breaks ties, which keeps the order deterministic.
+    std::vector<std::pair<double, unsigned>> keys(size);
+    for (unsigned i = 0; i < size; i++) {
+        keys[i] = std::make_pair(architectures.fitness(i), i);
+    }
 
-template<typename T>
-std::pair<T, T> GeneticAlgorithm::crossover_helper(const T& val1, const T& val2) {
-    const unsigned res_size = 8 * sizeof(T);
-    std::bitset<res_size> set1{static_cast<unsigned long>(val1)};
-    std::bitset<res_size> set2{static_cast<unsigned long>(val2)};
-    std::bitset<res_size> res;
-    res = set1 ^ set2;
-
-    T avg = (val1 + val2) / 2;
-
-    return std::make_pair(static_cast<T>(res.to_ulong()), avg);
-}
-
-void GeneticAlgorithm::sort_population() {
-    const auto comp = [](const Architecture& a, const Architecture& b) {
-        auto a_avg = (a.vs_ref_crit_path() + a.vs_ref_area()) / 2;
-        auto b_avg = (b.vs_ref_crit_path() + b.vs_ref_area()) / 2;
-        // The smaller the ration compared to ref the better
-        return a_avg < b_avg;
-    };
-    std::sort(architectures.begin(), architectures.end(), comp);
+    if (ranked == size) {
+        std::sort(keys.begin(), keys.end());
+    }
+    else {
+        // The smaller the ratio compared to ref the better
+        std::nth_element(keys.begin(), keys.begin() + ranked, keys.end());
+        std::sort(keys.begin(), keys.begin() + ranked);
+        // Keep the worst one last for get_worst
+        auto worst = std::max_element(keys.begin() + ranked, keys.end());
+        std::iter_swap(worst, keys.end() - 1);
+    }
+
+    std::vector<unsigned> order(size);
+    for (unsigned i = 0; i < size; i++) {
+        order[i] = keys[i].second;
+    }
+    scratch.gather(architectures, order);
+    architectures.swap(scratch);
 }
@@ -1,15 +1,35 @@
 #ifndef GENETIC_ALGORITHM_H_
 #define GENETIC_ALGORITHM_H_
 
+#include "AnalyticModel.h"
 #include "Architecture.h"
+#include "BayesianOptimizer.h"
+#include "EvaluationArchive.h"
+#include "Operators.h"
+#include "ParetoArchive.h"
+#include "Philox.h"
+#include "Population.h"
+#include "Random.h"
+#include "Sampling.h"
+#include "Selection.h"
+#include "Surrogate.h"
+#include "Termination.h"
 
 #include <algorithm>
-#include <bitset>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdio>
 #include <functional>
+#include <limits>
+#include <memory>
 #include <numeric>
 #include <random>
+#include <stdexcept>
 #include <string>
 #include <tuple>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -22,6 +42,39 @@ public:
     using results_t = std::tuple<unsigned, double, double>;
     using Comparator = std::function<bool(const results_t&, const results_t&)>;
 
+    /* Where the mutation amount and occurrence rate come from */
+    enum class Adaptation {
+        /* The values in Params, for the whole run */
+        NONE,
+        /* Each individual carries its own. After a mutant has been run,
+         * they grow if it beat its parent and shrink otherwise, so that
+         * about a fifth of the mutations succeed (1/5th success rule). */
+        ONE_FIFTH,
+        /* Each individual carries its own, and every child gets a
+         * log-normally perturbed copy */
+        LOG_NORMAL
+    };
+
+    /* What the population is ranked by */
+    enum class Objective {
+        /* The average of the critical path and area ratios (see
+         * Population::fitness) */
+        WEIGHTED,
+        /* Non-dominated front first, then crowding distance (NSGA-II), on
+         * the critical path and area ratios. Every architecture that is
+         * not dominated is kept in pareto_front(). */
+        PARETO
+    };
+
+    /* What makes the architectures of the next generation */
+    enum class Engine {
+        /* Selection, crossover and mutation */
+        GENETIC,
+        /* Gaussian process Bayesian optimisation of everything run so far
+         * (see BayesianOptimizer); the elites are still carried over */
+        BAYESIAN
+    };
+
     /**
      * Parameters used for the genetic algorithm.
      * See the definition of the default constructor of GeneticAlgorithm for
@@ -66,6 +119,40 @@ public:
         float mutation_amount;
         /* How often crossover happens */
         float crossover_occurrence_rate;
+        /* Whether to skip candidates that the analytic model rules out */
+        bool prescreen;
+        /* How much better than the analytic model VPR may do (see
+         * AnalyticModel::ratio_estimate) */
+        float prescreen_slack;
+        /* When to give up on routes that will not converge */
+        RouteMonitor::Rule route_rule;
+        /* How to pick the architectures to crossover/mutate from */
+        Selection::Scheme selection;
+        /* How many take part in each tournament */
+        unsigned tournament_size;
+        /* How genes are crossed and mutated */
+        Operators operators;
+        /* Whether the mutation amount and occurrence rate above are only
+         * the starting values */
+        Adaptation adaptation;
+        /* How the first generation is spread over the search space */
+        Sampling::Method initial_sampling;
+        /* How many of the best get a local search around them every
+         * generation (0 for none) */
+        unsigned local_search_elites;
+        /* How many new architectures the local search may run per
+         * generation */
+        unsigned local_search_budget;
+        /* What the population is ranked by */
+        Objective objective;
+        /* Which island this is (see IslandModel); each one has its own
+         * random streams */
+        unsigned island;
+        /* How many candidates to make for the surrogate to choose the
+         * next generation from (0 for no surrogate) */
+        unsigned surrogate_pool;
+        /* What makes the architectures of the next generation */
+        Engine engine;
     };
 
     /* Constructors, Destructor, and Assignment operators {{{ */
@@ -75,9 +162,11 @@ public:
     /**
      * Creates a genetic algorithm runner with the given parameters.
      * The number of population must be greater than 1.
+     * If no workspace is given, the current directory is used.
      */
     GeneticAlgorithm(const Params& params, const std::string& vtr_path,
-        const std::vector<Architecture::Benchmark>& benchmarks = {});
+        const std::vector<Architecture::Benchmark>& benchmarks = {},
+        const std::shared_ptr<Workspace>& workspace = nullptr);
 
     // Copy constructor
     GeneticAlgorithm(const GeneticAlgorithm& other);
@@ -104,36 +193,211 @@ public:
     void run_generation();
 
     /**
-     * \return the current best architecture with its parameters populated.
+     * The first part of run_generation: replaces the current generation
+     * with the next one, unless this is the first.
+     */
+    void begin_generation();
+
+    /**
+     * The part of run_generation after evaluate: throws away the failed
+     * architectures, then selects, crosses over and mutates.
      */
-    const Architecture& get_best() const;
+    void end_generation();
+
+    /**
+     * Starts the first generation from architectures of earlier runs (see
+     * WarmStart), with their results, so they are not run again. The rest of
+     * the first generation is made anew with the initial sampling method.
+     * Throws std::logic_error once a generation has been run.
+     *
+     * \param[in] seeds the rows of results to start from, at most the
+     *            population size of them.
+     */
+    void warm_start(const Population& results, const std::vector<unsigned>& seeds);
+
+    /**
+     * Measures every architecture against the results of the given one
+     * from now on. Islands share one this way (see IslandModel). While it
+     * has no results, it is set at the end of the first generation from the
+     * baseline (see set_baseline), or else from the first architecture that
+     * did not fail.
+     */
+    void set_reference(const std::shared_ptr<Architecture>& reference);
+
+    /**
+     * \return the architecture the fitness is measured against, without
+     *         results until it is set.
+     */
+    const Architecture& reference() const;
+
+    /**
+     * Runs the given architecture with the first generation, and measures
+     * everything against it if it does not fail. It stays in the
+     * population like any other. Throws std::logic_error once a generation
+     * has been run.
+     */
+    void set_baseline(const Architecture::Genome::Values& genome);
+
+    /**
+     * \return the architecture with the given name: kK_NN with an optional
+     *         _WW (the channel width, DEFAULT_BASELINE_W if not given), e.g.
+     *         k6_N10 like the VTR architecture the template is based on, or
+     *         K,N,W. Throws std::invalid_argument for anything else or for
+     *         values out of range.
+     */
+    static Architecture::Genome::Values parse_baseline(const std::string& name);
+
+    /* Channel width of a baseline given without one */
+    static const unsigned DEFAULT_BASELINE_W;
 
     /**
      * \return the current best architecture with its parameters populated.
      */
-    const Architecture& get_worst() const;
+    Architecture get_best() const;
+
+    /**
+     * \return the current worst architecture with its parameters populated.
+     */
+    Architecture get_worst() const;
 
     /**
      * \return the population.
      */
-    const std::vector<Architecture>& population() const;
+    const Population& population() const;
 
     /**
      * \return the parameters for the genetic algorithm.
      */
     const Params& parameters() const;
 
+    /**
+     * \return the adaptation with the given name (none, one-fifth or
+     *         log-normal). Throws std::invalid_argument for anything else.
+     */
+    static Adaptation parse_adaptation(const std::string& name);
+
+    /**
+     * \return the mutation parameters after a mutant made with them was run:
+     *         both grown if it beat its parent, shrunk otherwise (the 1/5th
+     *         success rule), within their bounds.
+     */
+    static Population::Strategy one_fifth_step(const Population::Strategy& strategy,
+                                               bool success);
+
+    /**
+     * \return the mutation parameters of a mutant: the amount and the odds
+     *         of the rate each multiplied by a log-normal step, within their
+     *         bounds.
+     */
+    static Population::Strategy log_normal_step(const Population::Strategy& strategy,
+                                                Philox& rng);
+
+    /**
+     * \return the engine with the given name (genetic or bayesian).
+     *         Throws std::invalid_argument for anything else.
+     */
+    static Engine parse_engine(const std::string& name);
+
+    /**
+     * \return the objective with the given name (weighted or pareto).
+     *         Throws std::invalid_argument for anything else.
+     */
+    static Objective parse_objective(const std::string& name);
+
+    /**
+     * \return the architectures that no other one has beaten on both
+     *         critical path and area so far, in the PARETO mode.
+     */
+    const ParetoArchive& pareto_front() const;
+
+    /**
+     * \return the mutation amount and occurrence rate in effect, i.e. the
+     *         average over the population when they are adapted.
+     */
+    Population::Strategy mutation_strategy() const;
+
+    /**
+     * \return the number of candidates skipped by the pre-screening so far.
+     */
+    unsigned num_prescreened() const;
+
+    /**
+     * \return the number of architectures run by the local search so far.
+     */
+    unsigned num_local_evaluations() const;
+
+    /**
+     * \return Spearman's rank correlation between the fitness the surrogate
+     *         predicted for the architectures of the last generation and the
+     *         one they got, or NaN if it is not known yet.
+     */
+    double surrogate_correlation() const;
+
+    /**
+     * \return the number of generations run so far.
+     */
+    unsigned num_generations() const;
+
+    /**
+     * Records every architecture evaluated from now on in the archive.
+     * Pass nullptr to stop recording.
+     */
+    void set_archive(const std::shared_ptr<EvaluationArchive>& archive);
+
+    /**
+     * Only starts the evaluations that are expected to finish within the
+     * budgets of termination; the others are marked OUT_OF_BUDGET. Pass
+     * nullptr to run everything.
+     */
+    void set_termination(const std::shared_ptr<Termination>& termination);
+
     /**
      * Evaluates and populates performance of the current population by
-     * calling VPR.
+     * calling VPR. If pre-screening is enabled, candidates whose best case
+     * (according to AnalyticModel) is worse than every architecture that
+     * survived so far are marked as failed without running VPR.
      */
     void evaluate();
 
     /**
-     * Performs a roulette selection on the population, adding the current
-     * population to the next population in a random order, but biased in such
-     * a way that the superior entities are added earlier to avoid being
-     * eliminated when the generation change happens.
+     * The parts of evaluate, for running several populations at once:
+     * begin_evaluation pre-screens and returns the architectures to run,
+     * evaluate_one runs one of them (in parallel with the others), and
+     * end_evaluation records them all.
+     */
+    std::vector<unsigned> begin_evaluation();
+    void evaluate_one(unsigned i);
+    void end_evaluation(const std::vector<unsigned>& fresh);
+
+    /**
+     * Runs the architectures of batch that have not been run yet in
+     * parallel, the same way as evaluate(), and calls done(i) for each one
+     * as soon as it has finished, one call at a time. Nothing is
+     * pre-screened.
+     *
+     * \param[in] jobs identifies the run of each architecture, for the seeds
+     *            given to VPR.
+     */
+    void evaluate(Population& batch, const std::vector<std::uint64_t>& jobs,
+                  const std::function<void(unsigned)>& done);
+
+    /**
+     * \return the indices of the best count architectures of the current
+     *         population that have been run without failing (by fitness, or
+     *         by front and crowding distance in the PARETO mode), best first.
+     */
+    std::vector<unsigned> best(unsigned count) const;
+
+    /**
+     * Adds an architecture of another population, with its results, to the
+     * next generation in place of one of the last children.
+     */
+    void immigrate(const Population& from, unsigned i);
+
+    /**
+     * Selects distinct architectures to crossover/mutate from, using the
+     * scheme given in the parameters. Superior entities are more likely to
+     * be selected.
      */
     void select();
 
@@ -155,104 +419,203 @@ public:
 
     /**
      * Replaces the current generation with the next generation.
-     * The current generation needs to be sorted before the call to this
-     * method in the order of most superior to least superior (i.e. best
-     * performance first, worst performance last). This is important when the
-     * next generation contains less entities than the current generation
-     * (since that's when some entities from the current generation are used
-     * again in the next generation).
+     * The immigrants take the place of the last children, the next
+     * generation is filled up with random architectures if needed, then
+     * the two buffers are swapped.
      */
     void change_generation();
 
 private:
-    static std::random_device rd;
-    static std::mt19937_64 gen;
-    static std::uniform_real_distribution<float> prob_gen;
-
     Params params;
-    std::vector<Architecture::Benchmark> benchmarks;
-    std::vector<Architecture> architectures;
+    /* The current generation */
+    Population architectures;
     std::string vtr_path;
 
+    /* Where the architecture files and the ABC/VPR runs go */
+    std::shared_ptr<Workspace> workspace;
+
+    /* The architecture the fitness is measured against, with its results.
+     * Every population of this instance points to it; copies share it. */
+    std::shared_ptr<Architecture> reference_arch;
+
+    /* Run with the first generation to become the reference, if set */
+    Architecture::Genome::Values baseline;
+    bool has_baseline;
+
+    /* Number of candidates skipped by the pre-screening */
+    unsigned prescreened;
+
+    /* Where the evaluations are recorded, if anywhere */
+    std::shared_ptr<EvaluationArchive> archive;
+
+    /* Decides which evaluations still fit in the budget, if set */
+    std::shared_ptr<Termination> termination;
+
+    /* Every architecture run so far, when the local search needs them, and
+     * where each genome is in it. Rows that were not run are not in the
+     * index. */
+    Population known;
+    std::unordered_map<std::uint64_t, unsigned> known_index;
+
+    /* Number of architectures run by the local search */
+    unsigned local_evaluations;
+
+    /* The non-dominated architectures, in the PARETO mode */
+    ParetoArchive pareto;
+
+    /* Trained on every architecture run, when there is a surrogate pool */
+    Surrogate surrogate;
+    /* What the surrogate predicted for the architectures it chose, by
+     * genome key, until they have been run */
+    std::unordered_map<std::uint64_t, double> predicted;
+    double correlation;
+
+    /* Fitted to every architecture run, in the BAYESIAN engine */
+    BayesianOptimizer optimizer;
+
+    /* The number of calls to run_generation */
+    unsigned generation;
+
     /**
-     * Architectures that will potentially be used for crossover and/on mutation.
+     * Indices of the architectures that will potentially be used for
+     * crossover and/on mutation.
      */
-    std::vector<Architecture> selected;
+    std::vector<unsigned> selected;
 
     /**
      * The population for the next generation.
      * If the number is less than the population size defined in the params,
-     * the lower-ranked entities from the previous generation should be
-     * replaced.
+     * random architectures are added when the generation changes.
      */
-    std::vector<Architecture> next_generation;
+    Population next_generation;
+
+    /* Architectures from other islands for the next generation */
+    Population immigrants;
+
+    /* Where the population is reordered when sorting */
+    Population scratch;
+
+    /* Picks from the survivors of each generation */
+    Selection selection;
+
+    /* For the decisions of the algorithm itself (see Random) */
+    Philox rng;
+    /* Random individuals so far; each has its own stream */
+    std::uint64_t num_random;
+
+    /* Private methods */
 
     /**
-     * Used for generating biased random indices for selection.
-     * Has length of (architectures.size() - params.elites_preserve).
+     * Adds random architectures until the population has the given size.
      */
-    std::vector<unsigned> weights;
+    void fill_random_population(Population& population, unsigned size);
 
-    // For the get_biased_index method
-    std::uniform_real_distribution<float> biased_gen;
+    /**
+     * Adds count architectures to the first generation with the initial
+     * sampling method.
+     */
+    void fill_initial_population(unsigned count);
 
-    /* Private methods */
+    /**
+     * \return the mutation parameters of a new random architecture.
+     */
+    Population::Strategy initial_strategy() const;
 
     /**
-     * Fills in the vector of architectures for the given range.
+     * Applies the 1/5th success rule to the mutants that were just run.
      */
-    template<typename ForwardIter>
-    void fill_random_population(const ForwardIter& begin,
-                                const ForwardIter& end);
+    void adapt();
 
     /**
-     * Whether or not to trigger an event, given a probability that it
-     * happens.
-     * An event could be something like mutation or crossover.
-     *
-     * \param[in] probability the probability that true is returned.
+     * \return the id of a random stream of this island (see Random).
+     */
+    std::uint64_t stream_id(std::uint64_t id) const;
+
+    /**
+     * Runs ABC and VPR on one architecture of the population, unless it
+     * would not finish within the budget.
      *
-     * \return true at given probability.
+     * \param[in] job identifies the run, for the seeds given to VPR.
      */
-    bool trigger(const float probability);
+    void run(Population& population, unsigned i, std::uint64_t job);
 
     /**
-     * Randomly selects two elements with different indices.
+     * Adds the results of an architecture to the known ones, unless it was
+     * not run.
+     */
+    void remember(const Population& population, unsigned i);
+
+    /**
+     * Moves each of the best architectures to its best neighbour (see
+     * Architecture::Genome::neighbours) until none is better, running at
+     * most local_search_budget new ones. Improved architectures are added
+     * to the population, unless it already has them.
      *
-     * \return pair of two elements with different indices.
+     * \return true if any was added.
      */
-    template<typename T>
-    std::pair<T, T> get_two_random(const std::vector<T>& vec);
+    bool local_search();
 
     /**
-     * Generates a biased index in the range [offset, architectures.size()).
+     * Runs the neighbours of genome that are not known yet, while the
+     * budget lasts.
      *
-     * \param[in] offset the lower bound of the random index. Default: 0.
+     * \return the rows of known with the results of the neighbours.
+     */
+    std::vector<unsigned> run_neighbours(const Architecture::Genome::Values& genome,
+                                         unsigned& budget);
+
+    /**
+     * Trains the surrogate on the current population, and compares what it
+     * predicted for it with what it got.
+     */
+    void train_surrogate();
+
+    /**
+     * Adds candidates to the children in the next generation until there
+     * are surrogate_pool, then keeps the ones the surrogate predicts to be
+     * the best, and some of the ones it knows the least about.
+     */
+    void screen_offspring();
+
+    /**
+     * Marks the unevaluated architectures that are not expected to beat
+     * the current survivors as failed: worse than the worst of them, or in
+     * the PARETO mode dominated by every one of them.
      */
-    unsigned get_biased_index(const unsigned offset = 0);
+    void prescreen();
 
     /**
-     * Helper method for the crossover operation.
-     * Given two values, does an XOR operation on the bit string and also
-     * takes the average of the two. Thus, the parameters are assumed to be
-     * addable and divisible by an integer.
+     * Whether or not to trigger an event, given a probability that it
+     * happens.
+     * An event could be something like mutation or crossover.
      *
-     * \param[in] val1 the first value.
+     * \param[in] probability the probability that true is returned.
      *
-     * \param[in] val2 the second value.
+     * \return true at given probability.
+     */
+    bool trigger(const float probability);
+
+    /**
+     * Randomly selects two elements with different indices.
      *
-     * \return pair of new values.
+     * \return pair of two elements with different indices.
      */
     template<typename T>
-    std::pair<T, T> crossover_helper(const T& val1, const T& val2);
+    std::pair<T, T> get_two_random(const std::vector<T>& vec);
 
     /**
      * Sorts the `architectures' vector (the current population) according to
      * the total performance gain observed among all benchmarks compared to
-     * reference values (the results from the first generation). No operation
-     * is done for the first generation.
+     * the reference architecture, or by front and crowding distance in the
+     * PARETO mode.
+     * The fitness of each architecture is computed once and the population
+     * is reordered afterwards.
+     *
+     * \param[in] ranked how many of the best need to be in order. The rest
+     *            are only guaranteed to be worse, with the worst at the back.
+     *            Default: all of them.
      */
-    void sort_population();
+    void sort_population(unsigned ranked = UINT_MAX);
 };
 
 #endif /* end of include guard */
@@ -0,0 +1,303 @@
+#ifndef GENOME_H_
+#define GENOME_H_
+
+#include "Operators.h"
+#include "Philox.h"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * One integer gene. The valid values are Min, Min + Step, Min + 2 * Step, ...
+ * up to Max, e.g. Gene<2, 250, 2> for an even channel width.
+ */
+template<unsigned Min, unsigned Max, unsigned Step = 1>
+struct Gene {
+    static_assert(Min <= Max, "empty gene range");
+    static_assert(Step > 0, "gene step must be positive");
+
+    static constexpr unsigned min = Min;
+    /* The largest valid value, which is Max only if it is on the grid */
+    static constexpr unsigned max = Min + (Max - Min) / Step * Step;
+    static constexpr unsigned step = Step;
+    /* Number of valid values */
+    static constexpr unsigned count = (Max - Min) / Step + 1;
+
+    /**
+     * \return the valid value closest to value: clamped to the range, and
+     *         rounded up to the grid.
+     */
+    static constexpr unsigned repair(long value) {
+        return value <= static_cast<long>(min) ? min
+            : value >= static_cast<long>(max) ? max
+            : min + (static_cast<unsigned>(value) - min + step - 1) / step * step;
+    }
+
+    static constexpr bool valid(unsigned value) {
+        return value >= min && value <= max && (value - min) % step == 0;
+    }
+
+    /**
+     * \return the valid value for a point in [0, 1), each taking an equal
+     *         share of the interval.
+     */
+    static unsigned from_unit(double u) {
+        const double cell = std::floor(u * count);
+        return cell <= 0 ? min
+            : cell >= count - 1 ? max
+            : min + static_cast<unsigned>(cell) * step;
+    }
+
+    /**
+     * \return the middle of the share of [0, 1) from_unit maps to value.
+     */
+    static double to_unit(unsigned value) {
+        return ((static_cast<double>(value) - min) / step + 0.5) / count;
+    }
+
+    /**
+     * \return a valid value drawn uniformly.
+     */
+    static unsigned random(Philox& rng) {
+        std::uniform_int_distribution<unsigned> dist{0, count - 1};
+        return min + dist(rng) * step;
+    }
+};
+
+template<unsigned Min, unsigned Max, unsigned Step>
+constexpr unsigned Gene<Min, Max, Step>::min;
+template<unsigned Min, unsigned Max, unsigned Step>
+constexpr unsigned Gene<Min, Max, Step>::max;
+template<unsigned Min, unsigned Max, unsigned Step>
+constexpr unsigned Gene<Min, Max, Step>::step;
+template<unsigned Min, unsigned Max, unsigned Step>
+constexpr unsigned Gene<Min, Max, Step>::count;
+
+/**
+ * The genetic operators of a genome made of the given genes.
+ *
+ * Everything is unrolled over the genes at compile time, so a new gene only
+ * needs a new entry in the list (see Architecture::Genome) and none of the
+ * loops over the population get slower or need to be touched.
+ */
+template<typename... Genes>
+class GenomeDescriptor {
+public:
+    static constexpr std::size_t size = sizeof...(Genes);
+    /* Bits of each gene in key() */
+    static constexpr unsigned KEY_BITS = 64 / size;
+
+    using Values = std::array<unsigned, size>;
+
+    template<std::size_t I>
+    using GeneAt = typename std::tuple_element<I, std::tuple<Genes...>>::type;
+
+    /**
+     * \return valid values drawn uniformly.
+     */
+    static Values random(Philox& rng) {
+        Values values;
+        random(values, rng, Index<0>{});
+        return values;
+    }
+
+    /**
+     * \return the genome for a point of the unit cube (see Sampling), one
+     *         coordinate per gene.
+     */
+    static Values from_unit(const std::vector<double>& point) {
+        Values values;
+        from_unit(values, point, Index<0>{});
+        return values;
+    }
+
+    /**
+     * \return the point of the unit cube from_unit maps to values.
+     */
+    static std::vector<double> to_unit(const Values& values) {
+        std::vector<double> point(size);
+        to_unit(values, point, Index<0>{});
+        return point;
+    }
+
+    /**
+     * \return the valid genomes one step away from values in a single gene,
+     *         lower neighbour first, gene by gene.
+     */
+    static std::vector<Values> neighbours(const Values& values) {
+        std::vector<Values> result;
+        result.reserve(2 * size);
+        neighbours(values, result, Index<0>{});
+        return result;
+    }
+
+    /**
+     * Mutates each gene with the given operators, then repairs.
+     */
+    static void mutate(Values& values, float amount, Philox& rng,
+                       const Operators& operators = Operators{}) {
+        mutate(values, amount, rng, operators, Index<0>{});
+    }
+
+    /**
+     * \return two children of the parents, crossed gene by gene with the
+     *         given operators and repaired.
+     */
+    static std::pair<Values, Values> crossover(const Values& a, const Values& b,
+                                               Philox& rng,
+                                               const Operators& operators = Operators{}) {
+        std::pair<Values, Values> children;
+        crossover(a, b, rng, operators, children, Index<0>{});
+        return children;
+    }
+
+    /**
+     * Moves every gene to its closest valid value.
+     */
+    static void repair(Values& values) {
+        repair(values, Index<0>{});
+    }
+
+    static bool valid(const Values& values) {
+        return valid(values, Index<0>{});
+    }
+
+    /**
+     * \return the genes packed in KEY_BITS each, which identifies the genome
+     *         as long as every gene fits (as all valid ones do).
+     */
+    static std::uint64_t key(const Values& values) {
+        return key(values, Index<0>{});
+    }
+
+    static bool equal(const Values& a, const Values& b) {
+        return equal(a, b, Index<0>{});
+    }
+
+private:
+    template<std::size_t I>
+    using Index = std::integral_constant<std::size_t, I>;
+
+    static constexpr std::uint64_t KEY_MASK = KEY_BITS == 64
+        ? ~static_cast<std::uint64_t>(0)
+        : (static_cast<std::uint64_t>(1) << KEY_BITS) - 1;
+
+    static_assert(size > 0 && size <= 64, "a genome has 1 to 64 genes");
+
+    /* The end of each recursion */
+    static void random(Values&, Philox&, Index<size>) { }
+    static void from_unit(Values&, const std::vector<double>&, Index<size>) { }
+    static void to_unit(const Values&, std::vector<double>&, Index<size>) { }
+    static void neighbours(const Values&, std::vector<Values>&, Index<size>) { }
+    static void mutate(Values&, float, Philox&, const Operators&,
+                       Index<size>) { }
+    static void crossover(const Values&, const Values&, Philox&,
+                          const Operators&, std::pair<Values, Values>&,
+                          Index<size>) { }
+    static void repair(Values&, Index<size>) { }
+    static bool valid(const Values&, Index<size>) {
+        return true;
+    }
+    static std::uint64_t key(const Values&, Index<size>) {
+        return 0;
+    }
+    static bool equal(const Values&, const Values&, Index<size>) {
+        return true;
+    }
+
+    template<std::size_t I>
+    static void random(Values& values, Philox& rng, Index<I>) {
+        values[I] = GeneAt<I>::random(rng);
+        random(values, rng, Index<I + 1>{});
+    }
+
+    template<std::size_t I>
+    static void from_unit(Values& values, const std::vector<double>& point,
+                          Index<I>) {
+        values[I] = GeneAt<I>::from_unit(point[I]);
+        from_unit(values, point, Index<I + 1>{});
+    }
+
+    template<std::size_t I>
+    static void to_unit(const Values& values, std::vector<double>& point,
+                        Index<I>) {
+        point[I] = GeneAt<I>::to_unit(values[I]);
+        to_unit(values, point, Index<I + 1>{});
+    }
+
+    template<std::size_t I>
+    static void neighbours(const Values& values, std::vector<Values>& result,
+                           Index<I>) {
+        using G = GeneAt<I>;
+        if (values[I] >= G::min + G::step) {
+            result.push_back(values);
+            result.back()[I] -= G::step;
+        }
+        if (values[I] + G::step <= G::max) {
+            result.push_back(values);
+            result.back()[I] += G::step;
+        }
+        neighbours(values, result, Index<I + 1>{});
+    }
+
+    template<std::size_t I>
+    static void mutate(Values& values, float amount, Philox& rng,
+                       const Operators& operators, Index<I>) {
+        using G = GeneAt<I>;
+        values[I] = G::repair(operators.mutate(values[I], amount, G::min,
+                                               G::step, G::count, rng));
+        mutate(values, amount, rng, operators, Index<I + 1>{});
+    }
+
+    template<std::size_t I>
+    static void crossover(const Values& a, const Values& b, Philox& rng,
+                          const Operators& operators,
+                          std::pair<Values, Values>& children, Index<I>) {
+        using G = GeneAt<I>;
+        std::pair<long, long> genes = operators.cross(a[I], b[I], G::min,
+                                                      G::step, G::count, rng);
+        children.first[I] = G::repair(genes.first);
+        children.second[I] = G::repair(genes.second);
+        crossover(a, b, rng, operators, children, Index<I + 1>{});
+    }
+
+    template<std::size_t I>
+    static void repair(Values& values, Index<I>) {
+        values[I] = GeneAt<I>::repair(values[I]);
+        repair(values, Index<I + 1>{});
+    }
+
+    template<std::size_t I>
+    static bool valid(const Values& values, Index<I>) {
+        return GeneAt<I>::valid(values[I]) && valid(values, Index<I + 1>{});
+    }
+
+    template<std::size_t I>
+    static std::uint64_t key(const Values& values, Index<I>) {
+        static_assert(GeneAt<I>::max <= KEY_MASK, "gene does not fit in the key");
+        return (static_cast<std::uint64_t>(values[I] & KEY_MASK)
+                << (KEY_BITS * (size - 1 - I)))
+            | key(values, Index<I + 1>{});
+    }
+
+    template<std::size_t I>
+    static bool equal(const Values& a, const Values& b, Index<I>) {
+        return a[I] == b[I] && equal(a, b, Index<I + 1>{});
+    }
+};
+
+template<typename... Genes>
+constexpr std::size_t GenomeDescriptor<Genes...>::size;
+template<typename... Genes>
+constexpr unsigned GenomeDescriptor<Genes...>::KEY_BITS;
+template<typename... Genes>
+constexpr std::uint64_t GenomeDescriptor<Genes...>::KEY_MASK;
+
+#endif /* end of include guard */
@@ -0,0 +1,262 @@
+#include "IslandModel.h"
+
+#include "Random.h"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+using Params = GeneticAlgorithm::Params;
+using Strategy = Population::Strategy;
+
+/* Constructors, Destructor, and Assignment operators {{{ */
+// Default constructor
+IslandModel::Migration::Migration()
+    : topology{Topology::RING}
+    , interval{0}
+    , migrants{1}
+{ }
+
+IslandModel::IslandModel(const std::vector<Params>& params,
+                         const std::string& vtr_path,
+                         const std::vector<Architecture::Benchmark>& benchmarks,
+                         const std::shared_ptr<Workspace>& workspace,
+                         const Migration& migration)
+    : island{}
+    , migration(migration)
+    , combined{benchmarks}
+    , pareto{}
+    , generation{0}
+    , migrations{0}
+    , rng{Random::stream(Random::Domain::MIGRATION, 0)}
+{
+    if (params.empty()) {
+        throw std::invalid_argument{"An island model needs at least one island"};
+    }
+    // One workspace for all, so they share the scratch directory
+    auto shared = workspace ? workspace : std::make_shared<Workspace>();
+    island.reserve(params.size());
+    for (unsigned k = 0; k < params.size(); k++) {
+        Params p = params[k];
+        p.island = k;
+        island.emplace_back(p, vtr_path, benchmarks, shared);
+    }
+    // Fitness means the same on every island
+    set_reference(std::make_shared<Architecture>());
+}
+/* }}} */
+
+IslandModel::Topology IslandModel::parse_topology(const std::string& name) {
+    if (name == "ring") {
+        return Topology::RING;
+    }
+    if (name == "full") {
+        return Topology::FULL;
+    }
+    if (name == "random") {
+        return Topology::RANDOM;
+    }
+    throw std::invalid_argument{"Unknown migration topology " + name};
+}
+
+void IslandModel::run_generation() {
+    if (island.size() == 1) {
+        island[0].run_generation();
+        generation++;
+        return;
+    }
+
+    // The architectures of all islands go in one loop, so no thread waits
+    // for a small island to finish
+    std::vector<std::vector<unsigned>> fresh(island.size());
+    std::vector<std::pair<unsigned, unsigned>> jobs;
+    for (unsigned k = 0; k < island.size(); k++) {
+        island[k].begin_generation();
+        fresh[k] = island[k].begin_evaluation();
+        for (unsigned i : fresh[k]) {
+            jobs.emplace_back(k, i);
+        }
+    }
+
+#pragma omp parallel for schedule(dynamic)
+    for (unsigned j = 0; j < jobs.size(); j++) {
+        island[jobs[j].first].evaluate_one(jobs[j].second);
+    }
+
+    for (unsigned k = 0; k < island.size(); k++) {
+        island[k].end_evaluation(fresh[k]);
+        island[k].end_generation();
+    }
+
+    generation++;
+    if (migration.interval > 0 && generation % migration.interval == 0) {
+        migrate();
+    }
+
+    combined.clear();
+    for (const GeneticAlgorithm& ga : island) {
+        for (unsigned i = 0; i < ga.population().size(); i++) {
+            combined.add(ga.population(), i);
+        }
+    }
+    if (island[0].parameters().objective == GeneticAlgorithm::Objective::PARETO) {
+        pareto.update(combined);
+    }
+}
+
+const Population& IslandModel::population() const {
+    return island.size() == 1 ? island[0].population() : combined;
+}
+
+Architecture IslandModel::get_best() const {
+    unsigned best = 0;
+    double fitness = 0;
+    bool found = false;
+    for (unsigned k = 0; k < island.size(); k++) {
+        if (island[k].population().empty()) {
+            continue;
+        }
+        const double f = island[k].get_best().fitness(reference());
+        if (!found || f < fitness) {
+            best = k;
+            fitness = f;
+            found = true;
+        }
+    }
+    return island[best].get_best();
+}
+
+Architecture IslandModel::get_worst() const {
+    unsigned worst = 0;
+    double fitness = 0;
+    bool found = false;
+    for (unsigned k = 0; k < island.size(); k++) {
+        if (island[k].population().empty()) {
+            continue;
+        }
+        const double f = island[k].get_worst().fitness(reference());
+        if (!found || f > fitness) {
+            worst = k;
+            fitness = f;
+            found = true;
+        }
+    }
+    return island[worst].get_worst();
+}
+
+Strategy IslandModel::mutation_strategy() const {
+    double amount = 0, rate = 0;
+    for (const GeneticAlgorithm& ga : island) {
+        const Strategy strategy = ga.mutation_strategy();
+        amount += strategy.mutation_amount;
+        rate += strategy.mutation_occurrence_rate;
+    }
+    return Strategy(amount / island.size(), rate / island.size());
+}
+
+const ParetoArchive& IslandModel::pareto_front() const {
+    return island.size() == 1 ? island[0].pareto_front() : pareto;
+}
+
+unsigned IslandModel::num_prescreened() const {
+    unsigned sum = 0;
+    for (const GeneticAlgorithm& ga : island) {
+        sum += ga.num_prescreened();
+    }
+    return sum;
+}
+
+unsigned IslandModel::num_local_evaluations() const {
+    unsigned sum = 0;
+    for (const GeneticAlgorithm& ga : island) {
+        sum += ga.num_local_evaluations();
+    }
+    return sum;
+}
+
+double IslandModel::surrogate_correlation() const {
+    double sum = 0;
+    unsigned count = 0;
+    for (const GeneticAlgorithm& ga : island) {
+        if (!std::isnan(ga.surrogate_correlation())) {
+            sum += ga.surrogate_correlation();
+            count++;
+        }
+    }
+    return count > 0 ? sum / count : std::numeric_limits<double>::quiet_NaN();
+}
+
+unsigned IslandModel::num_migrations() const {
+    return migrations;
+}
+
+void IslandModel::warm_start(const Population& results,
+                             const std::vector<unsigned>& seeds) {
+    std::vector<std::vector<unsigned>> dealt(island.size());
+    for (unsigned j = 0; j < seeds.size(); j++) {
+        dealt[j % island.size()].push_back(seeds[j]);
+    }
+    for (unsigned k = 0; k < island.size(); k++) {
+        island[k].warm_start(results, dealt[k]);
+    }
+}
+
+void IslandModel::set_archive(const std::shared_ptr<EvaluationArchive>& archive) {
+    for (GeneticAlgorithm& ga : island) {
+        ga.set_archive(archive);
+    }
+}
+
+void IslandModel::set_termination(const std::shared_ptr<Termination>& termination) {
+    for (GeneticAlgorithm& ga : island) {
+        ga.set_termination(termination);
+    }
+}
+
+void IslandModel::set_reference(const std::shared_ptr<Architecture>& reference) {
+    combined.set_reference(reference);
+    for (GeneticAlgorithm& ga : island) {
+        ga.set_reference(reference);
+    }
+}
+
+void IslandModel::set_baseline(const Architecture::Genome::Values& genome) {
+    island[0].set_baseline(genome);
+}
+
+const Architecture& IslandModel::reference() const {
+    return island[0].reference();
+}
+
+const std::vector<GeneticAlgorithm>& IslandModel::islands() const {
+    return island;
+}
+
+/* Private methods */
+
+void IslandModel::migrate() {
+    const unsigned n = island.size();
+    for (unsigned k = 0; k < n; k++) {
+        const Population& from = island[k].population();
+        for (unsigned i : island[k].best(migration.migrants)) {
+            switch (migration.topology) {
+            case Topology::RING:
+                island[(k + 1) % n].immigrate(from, i);
+                break;
+            case Topology::FULL:
+                for (unsigned to = 0; to < n; to++) {
+                    if (to != k) {
+                        island[to].immigrate(from, i);
+                    }
+                }
+                break;
+            case Topology::RANDOM:
+                // Any island but this one
+                island[(k + 1 + rng() % (n - 1)) % n].immigrate(from, i);
+                break;
+            }
+        }
+    }
+    migrations++;
+}
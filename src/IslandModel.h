@@ -0,0 +1,165 @@
+#ifndef ISLAND_MODEL_H_
+#define ISLAND_MODEL_H_
+
+#include "Architecture.h"
+#include "EvaluationArchive.h"
+#include "GeneticAlgorithm.h"
+#include "ParetoArchive.h"
+#include "Philox.h"
+#include "Population.h"
+#include "Termination.h"
+#include "Workspace.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Several genetic algorithms that evolve apart and every few generations
+ * send copies of their best architectures to each other.
+ *
+ * The islands run in lockstep in one process: each generation, the
+ * architectures of every island are run in one parallel loop, so the
+ * threads are kept busy as long as the islands together have enough to run.
+ * Migrants come with their results and are never run again. An island model
+ * with one island is the same as its genetic algorithm.
+ */
+class IslandModel {
+public:
+    /* Where the migrants of each island go */
+    enum class Topology {
+        /* To the next island */
+        RING,
+        /* To every other island */
+        FULL,
+        /* To another island drawn at random every time */
+        RANDOM
+    };
+
+    struct Migration {
+        // Default constructor
+        Migration();
+
+        Topology topology;
+        /* Generations between migrations, 0 for none */
+        unsigned interval;
+        /* How many of the best each island sends */
+        unsigned migrants;
+    };
+
+    /* Constructors, Destructor, and Assignment operators {{{ */
+    /**
+     * Creates an island for each of the parameters. Params::island is set
+     * to the position of each, so they all draw different random numbers.
+     */
+    IslandModel(const std::vector<GeneticAlgorithm::Params>& params,
+                const std::string& vtr_path,
+                const std::vector<Architecture::Benchmark>& benchmarks = {},
+                const std::shared_ptr<Workspace>& workspace = nullptr,
+                const Migration& migration = Migration{});
+    /* }}} */
+
+    /**
+     * \return the topology with the given name (ring, full or random).
+     *         Throws std::invalid_argument for anything else.
+     */
+    static Topology parse_topology(const std::string& name);
+
+    /**
+     * Runs one generation on every island, then migrates if it is time to.
+     */
+    void run_generation();
+
+    /**
+     * \return the population of every island together.
+     */
+    const Population& population() const;
+
+    /**
+     * \return the best of the best architectures of the islands.
+     */
+    Architecture get_best() const;
+
+    /**
+     * \return the worst of the worst architectures of the islands.
+     */
+    Architecture get_worst() const;
+
+    /**
+     * \return the average of the mutation parameters of the islands.
+     */
+    Population::Strategy mutation_strategy() const;
+
+    /**
+     * \return the architectures that no other one on any island has beaten
+     *         on both critical path and area, in the PARETO mode.
+     */
+    const ParetoArchive& pareto_front() const;
+
+    /**
+     * Sums over the islands; see GeneticAlgorithm.
+     */
+    unsigned num_prescreened() const;
+    unsigned num_local_evaluations() const;
+
+    /**
+     * \return the average over the islands that have one of the surrogate
+     *         rank correlation (see GeneticAlgorithm), or NaN.
+     */
+    double surrogate_correlation() const;
+
+    /**
+     * \return the number of times the islands have exchanged migrants.
+     */
+    unsigned num_migrations() const;
+
+    /**
+     * Starts the first generation of the islands from earlier results (see
+     * GeneticAlgorithm::warm_start), dealing the seeds out in turn, so every
+     * island gets some of the best.
+     */
+    void warm_start(const Population& results, const std::vector<unsigned>& seeds);
+
+    /**
+     * Passed on to every island; see GeneticAlgorithm.
+     */
+    void set_archive(const std::shared_ptr<EvaluationArchive>& archive);
+    void set_termination(const std::shared_ptr<Termination>& termination);
+    void set_reference(const std::shared_ptr<Architecture>& reference);
+
+    /**
+     * Runs the baseline on the first island only, since they all share
+     * the reference; see GeneticAlgorithm.
+     */
+    void set_baseline(const Architecture::Genome::Values& genome);
+
+    /**
+     * \return the architecture every island is measured against.
+     */
+    const Architecture& reference() const;
+
+    const std::vector<GeneticAlgorithm>& islands() const;
+
+private:
+    std::vector<GeneticAlgorithm> island;
+    const Migration migration;
+
+    /* The populations of all islands, when there is more than one */
+    Population combined;
+
+    /* Merged from the fronts of the islands */
+    ParetoArchive pareto;
+
+    unsigned generation;
+    unsigned migrations;
+
+    /* For the random topology */
+    Philox rng;
+
+    /**
+     * Sends the best of every island according to the topology.
+     */
+    void migrate();
+};
+
+#endif /* end of include guard */
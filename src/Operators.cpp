@@ -0,0 +1,184 @@
+#include "Operators.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+const double Operators::BLEND_ALPHA = 0.5;
+const double Operators::SBX_ETA = 10;
+const double Operators::POLYNOMIAL_ETA = 20;
+
+namespace {
+
+double uniform(Philox& rng) {
+    return std::generate_canonical<double, 53>(rng);
+}
+
+/* Position of value in its range, and back to the nearest valid value */
+double to_position(unsigned value, unsigned min, unsigned step) {
+    return (static_cast<double>(value) - min) / step;
+}
+
+long to_value(double position, unsigned min, unsigned step) {
+    return static_cast<long>(min) + std::lround(position) * static_cast<long>(step);
+}
+
+/* Moves a position that rounds back to where it was by one step, in the
+ * direction it was going (either way if it did not go anywhere) */
+double at_least_one_step(double from, double to, double last, Philox& rng) {
+    if (std::lround(to) != std::lround(from) || last == 0) {
+        return to;
+    }
+    bool up = to > from || (to == from && uniform(rng) < 0.5);
+    if (from == 0) {
+        up = true;
+    }
+    else if (from == last) {
+        up = false;
+    }
+    return from + (up ? 1 : -1);
+}
+
+/* The spread factor of bounded SBX for one side */
+double sbx_beta(double distance_to_bound, double gap, double u) {
+    const double beta = 1 + 2 * distance_to_bound / gap;
+    const double alpha = 2 - std::pow(beta, -(Operators::SBX_ETA + 1));
+    if (u <= 1 / alpha) {
+        return std::pow(u * alpha, 1 / (Operators::SBX_ETA + 1));
+    }
+    return std::pow(1 / (2 - u * alpha), 1 / (Operators::SBX_ETA + 1));
+}
+
+}
+
+/* Constructors, Destructor, and Assignment operators {{{ */
+// Default constructor
+Operators::Operators()
+    : Operators(Crossover::XOR, Mutation::GAUSSIAN)
+{ }
+
+Operators::Operators(Crossover crossover, Mutation mutation)
+    : crossover_type{crossover}
+    , mutation_type{mutation}
+{ }
+/* }}} */
+
+Operators::Crossover Operators::parse_crossover(const std::string& name) {
+    if (name == "xor") {
+        return Crossover::XOR;
+    }
+    if (name == "blend") {
+        return Crossover::BLEND;
+    }
+    if (name == "sbx") {
+        return Crossover::SBX;
+    }
+    throw std::invalid_argument{"Unknown crossover operator " + name};
+}
+
+Operators::Mutation Operators::parse_mutation(const std::string& name) {
+    if (name == "gaussian") {
+        return Mutation::GAUSSIAN;
+    }
+    if (name == "polynomial") {
+        return Mutation::POLYNOMIAL;
+    }
+    if (name == "discrete-gaussian") {
+        return Mutation::DISCRETE_GAUSSIAN;
+    }
+    throw std::invalid_argument{"Unknown mutation operator " + name};
+}
+
+std::pair<long, long> Operators::cross(unsigned a, unsigned b,
+                                       unsigned min, unsigned step,
+                                       unsigned count, Philox& rng) const {
+    if (crossover_type == Crossover::XOR) {
+        return std::make_pair(static_cast<long>(a ^ b),
+                              static_cast<long>((a + b) / 2));
+    }
+
+    const double last = count - 1;
+    const double lo = std::min(to_position(a, min, step), to_position(b, min, step));
+    const double hi = std::max(to_position(a, min, step), to_position(b, min, step));
+    const double gap = hi - lo;
+    double c1, c2;
+
+    if (crossover_type == Crossover::BLEND) {
+        const double from = std::max(lo - BLEND_ALPHA * gap, 0.0);
+        const double to = std::min(hi + BLEND_ALPHA * gap, last);
+        c1 = from + uniform(rng) * (to - from);
+        c2 = from + uniform(rng) * (to - from);
+    }
+    else {
+        // Same parents give the same children
+        if (gap < 0.5) {
+            return std::make_pair(static_cast<long>(a), static_cast<long>(b));
+        }
+        const double u = uniform(rng);
+        c1 = 0.5 * (lo + hi - sbx_beta(lo, gap, u) * gap);
+        c2 = 0.5 * (lo + hi + sbx_beta(last - hi, gap, u) * gap);
+        if (uniform(rng) < 0.5) {
+            std::swap(c1, c2);
+        }
+    }
+
+    c1 = std::min(std::max(c1, 0.0), last);
+    c2 = std::min(std::max(c2, 0.0), last);
+    return std::make_pair(to_value(c1, min, step), to_value(c2, min, step));
+}
+
+long Operators::mutate(unsigned value, float amount,
+                       unsigned min, unsigned step, unsigned count,
+                       Philox& rng) const {
+    if (amount == 0) {
+        return value;
+    }
+
+    if (mutation_type == Mutation::GAUSSIAN) {
+        std::normal_distribution<float> dist(value, value * amount);
+        return static_cast<long>(dist(rng));
+    }
+
+    const double last = count - 1;
+    const double x = std::min(std::max(to_position(value, min, step), 0.0), last);
+    double y;
+
+    if (mutation_type == Mutation::POLYNOMIAL) {
+        if (last == 0) {
+            return value;
+        }
+        // Deb's bounded polynomial mutation on [0, last]
+        const double u = uniform(rng);
+        const double power = 1 / (POLYNOMIAL_ETA + 1);
+        double delta;
+        if (u < 0.5) {
+            const double xy = 1 - x / last;
+            const double val = 2 * u + (1 - 2 * u) * std::pow(xy, POLYNOMIAL_ETA + 1);
+            delta = std::pow(val, power) - 1;
+        }
+        else {
+            const double xy = 1 - (last - x) / last;
+            const double val = 2 * (1 - u)
+                + 2 * (u - 0.5) * std::pow(xy, POLYNOMIAL_ETA + 1);
+            delta = 1 - std::pow(val, power);
+        }
+        y = x + delta * last;
+    }
+    else {
+        const double sigma = std::max(1.0, amount * last);
+        std::normal_distribution<double> dist(x, sigma);
+        y = dist(rng);
+    }
+
+    y = at_least_one_step(x, std::min(std::max(y, 0.0), last), last, rng);
+    return to_value(y, min, step);
+}
+
+Operators::Crossover Operators::crossover() const {
+    return crossover_type;
+}
+
+Operators::Mutation Operators::mutation() const {
+    return mutation_type;
+}
@@ -0,0 +1,92 @@
+#ifndef OPERATORS_H_
+#define OPERATORS_H_
+
+#include "Philox.h"
+
+#include <string>
+#include <utility>
+
+/**
+ * The crossover and mutation of a single integer gene, whose valid values are
+ * min, min + step, ..., min + (count - 1) * step (see Gene).
+ *
+ * Apart from XOR and GAUSSIAN, which are the operators the algorithm always
+ * used, they all work on the position of the value in its range, so that a
+ * child is never thrown outside of it and every gene moves by a number of
+ * steps that matches the size of its range. The results are rounded to the
+ * nearest valid value but not clamped; GenomeDescriptor repairs them.
+ */
+class Operators {
+public:
+    enum class Crossover {
+        /* Bitwise XOR of the parents and their average */
+        XOR,
+        /* BLX-alpha: uniform around the interval of the parents */
+        BLEND,
+        /* Simulated binary crossover, bounded to the range */
+        SBX
+    };
+
+    enum class Mutation {
+        /* Normal with a standard deviation of amount times the value */
+        GAUSSIAN,
+        /* Bounded polynomial mutation; amount is not used */
+        POLYNOMIAL,
+        /* Rounded normal with a standard deviation of amount times the
+         * range, moving at least one step */
+        DISCRETE_GAUSSIAN
+    };
+
+    /* How far around the parents BLEND goes, relative to their distance */
+    static const double BLEND_ALPHA;
+    /* Distribution indices; larger keeps children closer to the parents */
+    static const double SBX_ETA;
+    static const double POLYNOMIAL_ETA;
+
+    /* Constructors, Destructor, and Assignment operators {{{ */
+    // Default constructor
+    Operators();
+
+    Operators(Crossover crossover, Mutation mutation);
+    /* }}} */
+
+    /**
+     * \return the crossover with the given name (xor, blend or sbx).
+     *         Throws std::invalid_argument for anything else.
+     */
+    static Crossover parse_crossover(const std::string& name);
+
+    /**
+     * \return the mutation with the given name (gaussian, polynomial or
+     *         discrete-gaussian). Throws std::invalid_argument for anything
+     *         else.
+     */
+    static Mutation parse_mutation(const std::string& name);
+
+    /**
+     * Crosses one gene of two parents.
+     *
+     * \return the gene of each child.
+     */
+    std::pair<long, long> cross(unsigned a, unsigned b,
+                                unsigned min, unsigned step, unsigned count,
+                                Philox& rng) const;
+
+    /**
+     * Mutates one gene. An amount of 0 leaves it as it is.
+     *
+     * \return the new value.
+     */
+    long mutate(unsigned value, float amount,
+                unsigned min, unsigned step, unsigned count,
+                Philox& rng) const;
+
+    Crossover crossover() const;
+    Mutation mutation() const;
+
+private:
+    Crossover crossover_type;
+    Mutation mutation_type;
+};
+
+#endif /* end of include guard */
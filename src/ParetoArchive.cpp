@@ -0,0 +1,173 @@
+#include "ParetoArchive.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+/* Constructors, Destructor, and Assignment operators {{{ */
+// Default constructor
+ParetoArchive::ParetoArchive()
+    : archs{}
+    , objs{}
+{ }
+/* }}} */
+
+bool ParetoArchive::dominates(const Objectives& a, const Objectives& b) {
+    return a.first <= b.first && a.second <= b.second
+        && (a.first < b.first || a.second < b.second);
+}
+
+std::vector<unsigned> ParetoArchive::front_ranks(const std::vector<Objectives>& points) {
+    const unsigned n = points.size();
+    // Who each point dominates, and by how many it is dominated
+    std::vector<std::vector<unsigned>> dominated(n);
+    std::vector<unsigned> count(n, 0);
+    for (unsigned p = 0; p < n; p++) {
+        for (unsigned q = p + 1; q < n; q++) {
+            if (dominates(points[p], points[q])) {
+                dominated[p].push_back(q);
+                count[q]++;
+            }
+            else if (dominates(points[q], points[p])) {
+                dominated[q].push_back(p);
+                count[p]++;
+            }
+        }
+    }
+
+    std::vector<unsigned> ranks(n, 0);
+    std::vector<unsigned> current;
+    for (unsigned p = 0; p < n; p++) {
+        if (count[p] == 0) {
+            current.push_back(p);
+        }
+    }
+    // Peel off one front at a time
+    for (unsigned rank = 0; !current.empty(); rank++) {
+        std::vector<unsigned> next;
+        for (unsigned p : current) {
+            ranks[p] = rank;
+            for (unsigned q : dominated[p]) {
+                if (--count[q] == 0) {
+                    next.push_back(q);
+                }
+            }
+        }
+        current.swap(next);
+    }
+    return ranks;
+}
+
+std::vector<double> ParetoArchive::crowding_distances(const std::vector<Objectives>& points,
+                                                      const std::vector<unsigned>& ranks) {
+    const unsigned n = points.size();
+    const double infinity = std::numeric_limits<double>::infinity();
+    std::vector<double> distances(n, 0);
+
+    // By front, then by the objective
+    std::vector<unsigned> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    for (int objective = 0; objective < 2; objective++) {
+        auto value = [&](unsigned i) {
+            return objective == 0 ? points[i].first : points[i].second;
+        };
+        std::sort(order.begin(), order.end(), [&](unsigned a, unsigned b) {
+            return ranks[a] != ranks[b] ? ranks[a] < ranks[b]
+                : value(a) != value(b) ? value(a) < value(b)
+                : a < b;
+        });
+
+        for (unsigned begin = 0; begin < n; ) {
+            unsigned end = begin;
+            while (end < n && ranks[order[end]] == ranks[order[begin]]) {
+                end++;
+            }
+            distances[order[begin]] = infinity;
+            distances[order[end - 1]] = infinity;
+            const double range = value(order[end - 1]) - value(order[begin]);
+            if (range > 0) {
+                for (unsigned k = begin + 1; k + 1 < end; k++) {
+                    distances[order[k]] += (value(order[k + 1]) - value(order[k - 1]))
+                        / range;
+                }
+            }
+            begin = end;
+        }
+    }
+    return distances;
+}
+
+std::vector<unsigned> ParetoArchive::crowded_order(const std::vector<Objectives>& points) {
+    const std::vector<unsigned> ranks = front_ranks(points);
+    const std::vector<double> distances = crowding_distances(points, ranks);
+    // Compared one after the other, as a distance of zero in one front
+    // must not tie with an end of the next
+    std::vector<std::tuple<unsigned, double, unsigned>> keys(points.size());
+    for (unsigned i = 0; i < keys.size(); i++) {
+        keys[i] = std::make_tuple(ranks[i], -distances[i], i);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<unsigned> order(keys.size());
+    for (unsigned i = 0; i < keys.size(); i++) {
+        order[i] = std::get<2>(keys[i]);
+    }
+    return order;
+}
+
+ParetoArchive::Objectives ParetoArchive::objectives(const Population& population,
+                                                    unsigned i) {
+    return Objectives{population.vs_ref_crit_path(i), population.vs_ref_area(i)};
+}
+
+unsigned ParetoArchive::update(const Population& population) {
+    unsigned added = 0;
+    for (unsigned i = 0; i < population.size(); i++) {
+        if (!population.already_run(i) || !population.non_failed(i)) {
+            continue;
+        }
+
+        const Objectives point = objectives(population, i);
+        // Sorted by critical path, so only the ones before it can beat it
+        auto at = std::lower_bound(objs.begin(), objs.end(), point);
+        const bool beaten = std::any_of(objs.begin(), at, [&](const Objectives& o) {
+            return dominates(o, point);
+        }) || (at != objs.end() && *at == point);
+        if (beaten) {
+            continue;
+        }
+
+        // And only the ones after it can be beaten by it
+        unsigned pos = at - objs.begin();
+        unsigned kept = pos;
+        for (unsigned j = pos; j < objs.size(); j++) {
+            if (dominates(point, objs[j])) {
+                continue;
+            }
+            if (kept != j) {
+                objs[kept] = objs[j];
+                archs[kept] = std::move(archs[j]);
+            }
+            kept++;
+        }
+        objs.resize(kept);
+        archs.resize(kept);
+
+        objs.insert(objs.begin() + pos, point);
+        archs.insert(archs.begin() + pos, population.to_architecture(i));
+        added++;
+    }
+    return added;
+}
+
+const std::vector<Architecture>& ParetoArchive::front() const {
+    return archs;
+}
+
+const std::vector<ParetoArchive::Objectives>& ParetoArchive::points() const {
+    return objs;
+}
+
+unsigned ParetoArchive::size() const {
+    return archs.size();
+}
@@ -0,0 +1,92 @@
+#ifndef PARETO_ARCHIVE_H_
+#define PARETO_ARCHIVE_H_
+
+#include "Architecture.h"
+#include "Population.h"
+
+#include <tuple>
+#include <utility>
+#include <vector>
+
+/**
+ * The architectures no other one has beaten on both critical path and area,
+ * over a whole run.
+ *
+ * Both objectives are taken relative to the reference results (see
+ * Population::vs_ref_crit_path and vs_ref_area), lower being better. Also
+ * has the non-dominated sorting and crowding distance of NSGA-II, which
+ * GeneticAlgorithm ranks the population with in the PARETO mode.
+ */
+class ParetoArchive {
+public:
+    /* Critical path and area */
+    using Objectives = std::pair<double, double>;
+
+    /* Constructors, Destructor, and Assignment operators {{{ */
+    // Default constructor
+    ParetoArchive();
+    /* }}} */
+
+    /**
+     * \return true if a is no worse than b in both objectives and better in
+     *         at least one.
+     */
+    static bool dominates(const Objectives& a, const Objectives& b);
+
+    /**
+     * Fast non-dominated sorting.
+     *
+     * \return the front of each point: 0 for the ones nothing dominates, 1
+     *         for the ones only front 0 dominates, and so on.
+     */
+    static std::vector<unsigned> front_ranks(const std::vector<Objectives>& points);
+
+    /**
+     * \return the crowding distance of each point within its front: the sum
+     *         over both objectives of the normalised gap between its
+     *         neighbours. The ends of each front get infinity.
+     */
+    static std::vector<double> crowding_distances(const std::vector<Objectives>& points,
+                                                  const std::vector<unsigned>& ranks);
+
+    /**
+     * \return the points from best to worst by the crowded comparison of
+     *         NSGA-II: the lower front first, the larger crowding distance
+     *         within a front, and the lower index between equals.
+     */
+    static std::vector<unsigned> crowded_order(const std::vector<Objectives>& points);
+
+    /**
+     * \return the objectives of an architecture of the population.
+     */
+    static Objectives objectives(const Population& population, unsigned i);
+
+    /**
+     * Adds the architectures of the population that have been run without
+     * failing and are not dominated, and drops the ones they dominate. An
+     * architecture with the same objectives as one in the archive is not
+     * added.
+     *
+     * \return how many were added.
+     */
+    unsigned update(const Population& population);
+
+    /**
+     * \return the architectures, by increasing critical path (and so
+     *         decreasing area).
+     */
+    const std::vector<Architecture>& front() const;
+
+    /**
+     * \return the objectives of each architecture of front().
+     */
+    const std::vector<Objectives>& points() const;
+
+    unsigned size() const;
+
+private:
+    std::vector<Architecture> archs;
+    std::vector<Objectives> objs;
+};
+
+#endif /* end of include guard */
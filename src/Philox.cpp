@@ -0,0 +1,78 @@
+#include "Philox.h"
+
+namespace {
+
+const std::uint32_t M0 = 0xD2511F53;
+const std::uint32_t M1 = 0xCD9E8D57;
+const std::uint32_t W0 = 0x9E3779B9;
+const std::uint32_t W1 = 0xBB67AE85;
+
+inline void mulhilo(std::uint32_t a, std::uint32_t b,
+                    std::uint32_t& hi, std::uint32_t& lo) {
+    std::uint64_t product = static_cast<std::uint64_t>(a) * b;
+    hi = product >> 32;
+    lo = static_cast<std::uint32_t>(product);
+}
+
+}
+
+/* Constructors, Destructor, and Assignment operators {{{ */
+Philox::Philox(std::uint64_t seed, std::uint64_t stream)
+    : key{{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)}}
+    , stream{stream}
+    , position{0}
+    , buffer{}
+    , used{2}
+{ }
+/* }}} */
+
+Philox::result_type Philox::operator()() {
+    if (used == 2) {
+        Counter counter{{
+            static_cast<std::uint32_t>(position),
+            static_cast<std::uint32_t>(position >> 32),
+            static_cast<std::uint32_t>(stream),
+            static_cast<std::uint32_t>(stream >> 32)
+        }};
+        buffer = block(counter, key);
+        position++;
+        used = 0;
+    }
+
+    result_type result = (static_cast<result_type>(buffer[2 * used + 1]) << 32)
+        | buffer[2 * used];
+    used++;
+    return result;
+}
+
+void Philox::discard(unsigned long long n) {
+    // Use up what is left of the current block first
+    while (n > 0 && used < 2) {
+        used++;
+        n--;
+    }
+    position += n / 2;
+    if (n % 2 == 1) {
+        (*this)();
+    }
+}
+
+Philox::Counter Philox::block(Counter counter, Key key) {
+    for (unsigned round = 0; round < 10; round++) {
+        if (round > 0) {
+            key[0] += W0;
+            key[1] += W1;
+        }
+
+        std::uint32_t hi0, lo0, hi1, lo1;
+        mulhilo(M0, counter[0], hi0, lo0);
+        mulhilo(M1, counter[2], hi1, lo1);
+        counter = Counter{{
+            hi1 ^ counter[1] ^ key[0],
+            lo1,
+            hi0 ^ counter[3] ^ key[1],
+            lo0
+        }};
+    }
+    return counter;
+}
@@ -0,0 +1,66 @@
+#ifndef PHILOX_H_
+#define PHILOX_H_
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+/**
+ * Philox4x32-10 counter-based random number generator (Salmon et al.,
+ * "Parallel random numbers: as easy as 1, 2, 3", SC'11).
+ *
+ * The output is a bijection of a 128-bit counter under a 64-bit key, so any
+ * number of independent streams can be created by giving them different
+ * stream numbers (the upper half of the counter) without any shared state.
+ * Meets the requirements of UniformRandomBitGenerator, so it works with the
+ * distributions of <random>.
+ */
+class Philox {
+public:
+    using result_type = std::uint64_t;
+    using Counter = std::array<std::uint32_t, 4>;
+    using Key = std::array<std::uint32_t, 2>;
+
+    /* Constructors, Destructor, and Assignment operators {{{ */
+    /**
+     * \param[in] seed the key.
+     *
+     * \param[in] stream selects one of 2^64 streams of 2^64 blocks each.
+     */
+    Philox(std::uint64_t seed = 0, std::uint64_t stream = 0);
+    /* }}} */
+
+    static constexpr result_type min() {
+        return 0;
+    }
+
+    static constexpr result_type max() {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    /**
+     * \return the next 64 random bits.
+     */
+    result_type operator()();
+
+    /**
+     * Skips the next n outputs in constant time.
+     */
+    void discard(unsigned long long n);
+
+    /**
+     * The bijection itself: 10 rounds of Philox on one counter.
+     */
+    static Counter block(Counter counter, Key key);
+
+private:
+    Key key;
+    std::uint64_t stream;
+    /* Index of the next block */
+    std::uint64_t position;
+    /* The current block and how many of its two outputs are used */
+    Counter buffer;
+    unsigned used;
+};
+
+#endif /* end of include guard */
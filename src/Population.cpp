@@ -0,0 +1,287 @@
+#include "Population.h"
+
+#include <algorithm>
+
+using Benchmark = Architecture::Benchmark;
+
+/* Constructors, Destructor, and Assignment operators {{{ */
+// Default constructor
+Population::Result::Result()
+    : area{Benchmark::FAILED}
+    , crit_path{Benchmark::FAILED}
+    , is_populated{false}
+    , status{Status::NOT_RUN}
+    , stats{}
+{ }
+
+// Default constructor
+Population::Strategy::Strategy()
+    : Strategy(0, 0)
+{ }
+
+Population::Strategy::Strategy(float amount, float rate)
+    : mutation_amount{amount}
+    , mutation_occurrence_rate{rate}
+    , parent_fitness{-1}
+{ }
+
+// Default constructor
+Population::Population()
+    : names{std::make_shared<const std::vector<std::string>>()}
+    , ref{}
+    , k{}
+    , n{}
+    , w{}
+    , strategies{}
+    , results{}
+{ }
+
+Population::Population(const std::vector<Architecture::Benchmark>& benchmarks)
+    : names{}
+    , ref{}
+    , k{}
+    , n{}
+    , w{}
+    , strategies{}
+    , results{}
+{
+    std::vector<std::string> interned;
+    interned.reserve(benchmarks.size());
+    for (const Benchmark& b : benchmarks) {
+        interned.push_back(b.get_filename());
+    }
+    names = std::make_shared<const std::vector<std::string>>(std::move(interned));
+}
+/* }}} */
+
+bool Population::empty() const {
+    return k.empty();
+}
+
+void Population::set_reference(const std::shared_ptr<const Architecture>& reference) {
+    ref = reference;
+}
+
+const std::shared_ptr<const Architecture>& Population::reference() const {
+    return ref;
+}
+
+const std::string& Population::benchmark_name(unsigned b) const {
+    return (*names)[b];
+}
+
+void Population::clear() {
+    k.clear();
+    n.clear();
+    w.clear();
+    strategies.clear();
+    results.clear();
+}
+
+void Population::reserve(unsigned size) {
+    k.reserve(size);
+    n.reserve(size);
+    w.reserve(size);
+    strategies.reserve(size);
+    results.reserve(size * names->size());
+}
+
+unsigned Population::add(unsigned K, unsigned N, unsigned W) {
+    k.push_back(K);
+    n.push_back(N);
+    w.push_back(W);
+    strategies.emplace_back();
+    results.resize(results.size() + names->size());
+    return k.size() - 1;
+}
+
+unsigned Population::add(const Architecture::Genome::Values& genome,
+                         const Strategy& strategy) {
+    unsigned i = add(genome[Architecture::GENE_K],
+                     genome[Architecture::GENE_N],
+                     genome[Architecture::GENE_W]);
+    strategies[i] = strategy;
+    return i;
+}
+
+unsigned Population::add(const Population& other, unsigned i) {
+    if (k.empty()) {
+        names = other.names;
+    }
+    k.push_back(other.k[i]);
+    n.push_back(other.n[i]);
+    w.push_back(other.w[i]);
+    strategies.push_back(other.strategies[i]);
+    const unsigned B = names->size();
+    results.insert(results.end(),
+                   other.results.begin() + i * B,
+                   other.results.begin() + (i + 1) * B);
+    return k.size() - 1;
+}
+
+void Population::gather(const Population& other,
+                        const std::vector<unsigned>& order) {
+    names = other.names;
+    clear();
+    reserve(order.size());
+    for (unsigned i : order) {
+        add(other, i);
+    }
+}
+
+void Population::truncate(unsigned size) {
+    if (size >= k.size()) {
+        return;
+    }
+    k.resize(size);
+    n.resize(size);
+    w.resize(size);
+    strategies.resize(size);
+    results.resize(size * names->size());
+}
+
+void Population::remove_failed() {
+    const unsigned B = names->size();
+    unsigned kept = 0;
+    for (unsigned i = 0; i < k.size(); i++) {
+        if (!non_failed(i)) {
+            continue;
+        }
+        if (kept != i) {
+            k[kept] = k[i];
+            n[kept] = n[i];
+            w[kept] = w[i];
+            strategies[kept] = strategies[i];
+            std::copy(results.begin() + i * B,
+                      results.begin() + (i + 1) * B,
+                      results.begin() + kept * B);
+        }
+        kept++;
+    }
+    truncate(kept);
+}
+
+void Population::swap(Population& other) {
+    names.swap(other.names);
+    ref.swap(other.ref);
+    k.swap(other.k);
+    n.swap(other.n);
+    w.swap(other.w);
+    strategies.swap(other.strategies);
+    results.swap(other.results);
+}
+
+void Population::set_failed(unsigned i, Status why) {
+    for (unsigned b = 0; b < names->size(); b++) {
+        Result& r = result(i, b);
+        r.crit_path = Benchmark::FAILED;
+        r.area = Benchmark::FAILED;
+        r.is_populated = true;
+        r.status = why;
+    }
+}
+
+bool Population::already_run(unsigned i) const {
+    for (unsigned b = 0; b < names->size(); b++) {
+        if (!result(i, b).is_populated) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Population::non_failed(unsigned i) const {
+    for (unsigned b = 0; b < names->size(); b++) {
+        if (result(i, b).failed()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+double Population::vs_ref_crit_path(unsigned i) const {
+    static const std::vector<Benchmark> none;
+    const std::vector<Benchmark>& ref_bench = ref ? ref->bench : none;
+    double sum = 0;
+    for (unsigned b = 0; b < names->size(); b++) {
+        // If reference value is not set, then there's no performance change
+        if (b >= ref_bench.size() || !ref_bench[b].is_populated) {
+            return 1.0;
+        }
+
+        sum += result(i, b).crit_path / ref_bench[b].crit_path;
+    }
+
+    return sum / names->size();
+}
+
+double Population::vs_ref_area(unsigned i) const {
+    static const std::vector<Benchmark> none;
+    const std::vector<Benchmark>& ref_bench = ref ? ref->bench : none;
+    double sum = 0;
+    for (unsigned b = 0; b < names->size(); b++) {
+        // If reference value is not set, then there's no performance change
+        if (b >= ref_bench.size() || !ref_bench[b].is_populated) {
+            return 1.0;
+        }
+
+        sum += result(i, b).area / ref_bench[b].area;
+    }
+
+    return sum / names->size();
+}
+
+double Population::fitness(unsigned i) const {
+    return (vs_ref_crit_path(i) + vs_ref_area(i)) / 2;
+}
+
+Population::Stats Population::total_stats(unsigned i) const {
+    Stats total;
+    for (unsigned b = 0; b < names->size(); b++) {
+        total += result(i, b).stats;
+    }
+    return total;
+}
+
+Architecture Population::to_architecture(unsigned i) const {
+    std::vector<Benchmark> bench;
+    bench.reserve(names->size());
+    for (unsigned b = 0; b < names->size(); b++) {
+        const Result& r = result(i, b);
+        bench.emplace_back((*names)[b]);
+        bench.back().area = r.area;
+        bench.back().crit_path = r.crit_path;
+        bench.back().is_populated = r.is_populated;
+        bench.back().status = r.status;
+        bench.back().stats = r.stats;
+    }
+
+    Architecture arch;
+    arch.bench = std::move(bench);
+    arch.K = k[i];
+    arch.N = n[i];
+    arch.W = w[i];
+    return arch;
+}
+
+void Population::store(unsigned i, const Architecture& arch) {
+    for (unsigned b = 0; b < names->size() && b < arch.bench.size(); b++) {
+        const Benchmark& from = arch.bench[b];
+        Result& r = result(i, b);
+        r.area = from.area;
+        r.crit_path = from.crit_path;
+        r.is_populated = from.is_populated;
+        r.status = from.status;
+        r.stats = from.stats;
+    }
+}
+
+bool Population::operator==(const Population& other) const {
+    return k == other.k
+        && n == other.n
+        && w == other.w;
+}
+
+bool Population::operator!=(const Population& other) const {
+    return !(*this == other);
+}
@@ -0,0 +1,254 @@
+#ifndef POPULATION_H_
+#define POPULATION_H_
+
+#include "Architecture.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * The architectures of one generation, stored column by column.
+ *
+ * K, N and W are kept in one column each, and the results in a dense matrix
+ * with a row per individual and a column per benchmark. The benchmark names
+ * are interned once and shared by every copy, so adding, copying and
+ * reordering individuals only moves numbers around. An Architecture is only
+ * built (to_architecture) when one is needed to run ABC and VPR or to print
+ * it.
+ *
+ * The ratios and the fitness are taken against a reference architecture
+ * shared with the other populations of a run (see set_reference). It is kept
+ * by copies, clear() and swap(), but not taken from the populations that
+ * individuals are added from.
+ */
+class Population {
+public:
+    using Status = Architecture::Benchmark::Status;
+    using Stats = Architecture::Benchmark::Stats;
+
+    /* The results of one benchmark, like Architecture::Benchmark without
+     * the name */
+    struct Result {
+        // Default constructor
+        Result();
+
+        bool failed() const;
+
+        double area;
+        double crit_path;
+        bool is_populated;
+        Status status;
+        Stats stats;
+    };
+
+    /* How an individual mutates, when it carries its own mutation
+     * parameters (see GeneticAlgorithm::Adaptation) */
+    struct Strategy {
+        /* Constructors, Destructor, and Assignment operators {{{ */
+        // Default constructor
+        Strategy();
+
+        Strategy(float amount, float rate);
+        /* }}} */
+
+        /* Same as the Params of GeneticAlgorithm with the same name */
+        float mutation_amount;
+        float mutation_occurrence_rate;
+        /* Fitness of the parent it was mutated from until it has been run,
+         * negative otherwise */
+        double parent_fitness;
+    };
+
+    /* Constructors, Destructor, and Assignment operators {{{ */
+    // Default constructor
+    Population();
+
+    /**
+     * Creates an empty population that runs the given benchmarks.
+     */
+    Population(const std::vector<Architecture::Benchmark>& benchmarks);
+    /* }}} */
+
+    /**
+     * \return the number of individuals.
+     */
+    unsigned size() const;
+
+    bool empty() const;
+
+    /**
+     * \return the number of benchmarks, i.e. the columns of the results.
+     */
+    unsigned num_benchmarks() const;
+
+    /**
+     * Measures the individuals against the results of the given
+     * architecture, which may change afterwards. Without one, or while it has
+     * no results for a benchmark, every ratio is 1.
+     */
+    void set_reference(const std::shared_ptr<const Architecture>& reference);
+
+    /**
+     * \return the reference architecture, or nullptr.
+     */
+    const std::shared_ptr<const Architecture>& reference() const;
+
+    /**
+     * \return the file name of a benchmark.
+     */
+    const std::string& benchmark_name(unsigned b) const;
+
+    /**
+     * Removes all individuals, keeping the memory and the benchmarks.
+     */
+    void clear();
+
+    void reserve(unsigned n);
+
+    /**
+     * Adds an individual that has not been run yet.
+     *
+     * \return its index.
+     */
+    unsigned add(unsigned K, unsigned N, unsigned W);
+    unsigned add(const Architecture::Genome::Values& genome,
+                 const Strategy& strategy = Strategy{});
+
+    /**
+     * Adds a copy of an individual (genome and results) of another
+     * population with the same benchmarks.
+     *
+     * \return its index.
+     */
+    unsigned add(const Population& other, unsigned i);
+
+    /**
+     * Replaces the individuals with the ones at the given indices of another
+     * population, in that order.
+     */
+    void gather(const Population& other, const std::vector<unsigned>& order);
+
+    /**
+     * Keeps only the first n individuals.
+     */
+    void truncate(unsigned n);
+
+    /**
+     * Removes the individuals for which a benchmark failed, keeping the
+     * order of the others.
+     */
+    void remove_failed();
+
+    void swap(Population& other);
+
+    unsigned K(unsigned i) const;
+    unsigned N(unsigned i) const;
+    unsigned W(unsigned i) const;
+    Architecture::Genome::Values genome(unsigned i) const;
+
+    Strategy& strategy(unsigned i);
+    const Strategy& strategy(unsigned i) const;
+
+    Result& result(unsigned i, unsigned b);
+    const Result& result(unsigned i, unsigned b) const;
+
+    /**
+     * Marks all benchmarks of an individual as run without results.
+     */
+    void set_failed(unsigned i, Status why);
+
+    /**
+     * Same as the methods of Architecture with the same name.
+     */
+    bool already_run(unsigned i) const;
+    bool non_failed(unsigned i) const;
+    double vs_ref_crit_path(unsigned i) const;
+    double vs_ref_area(unsigned i) const;
+    double fitness(unsigned i) const;
+    Stats total_stats(unsigned i) const;
+
+    /**
+     * \return an architecture with the genome and the results of an
+     *         individual.
+     */
+    Architecture to_architecture(unsigned i) const;
+
+    /**
+     * Copies the results of an architecture that was built by
+     * to_architecture(i) and has been run since.
+     */
+    void store(unsigned i, const Architecture& arch);
+
+    /**
+     * Same genomes in the same order.
+     */
+    bool operator==(const Population& other) const;
+    bool operator!=(const Population& other) const;
+
+private:
+    /* Shared by all populations of a run */
+    std::shared_ptr<const std::vector<std::string>> names;
+    std::shared_ptr<const Architecture> ref;
+
+    std::vector<unsigned> k;
+    std::vector<unsigned> n;
+    std::vector<unsigned> w;
+    std::vector<Strategy> strategies;
+
+    /* size() x num_benchmarks(), row major */
+    std::vector<Result> results;
+};
+
+/* Inline methods */
+
+inline unsigned Population::size() const {
+    return k.size();
+}
+
+inline unsigned Population::num_benchmarks() const {
+    return names->size();
+}
+
+inline unsigned Population::K(unsigned i) const {
+    return k[i];
+}
+
+inline unsigned Population::N(unsigned i) const {
+    return n[i];
+}
+
+inline unsigned Population::W(unsigned i) const {
+    return w[i];
+}
+
+inline Architecture::Genome::Values Population::genome(unsigned i) const {
+    Architecture::Genome::Values values;
+    values[Architecture::GENE_K] = k[i];
+    values[Architecture::GENE_N] = n[i];
+    values[Architecture::GENE_W] = w[i];
+    return values;
+}
+
+inline Population::Strategy& Population::strategy(unsigned i) {
+    return strategies[i];
+}
+
+inline const Population::Strategy& Population::strategy(unsigned i) const {
+    return strategies[i];
+}
+
+inline Population::Result& Population::result(unsigned i, unsigned b) {
+    return results[i * names->size() + b];
+}
+
+inline const Population::Result& Population::result(unsigned i, unsigned b) const {
+    return results[i * names->size() + b];
+}
+
+inline bool Population::Result::failed() const {
+    return crit_path == Architecture::Benchmark::FAILED
+        || area == Architecture::Benchmark::FAILED;
+}
+
+#endif /* end of include guard */
@@ -0,0 +1,53 @@
+#include "Random.h"
+
+#include <mutex>
+#include <random>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+std::atomic<std::uint64_t> Random::value{0};
+std::atomic<bool> Random::is_set{false};
+std::atomic<unsigned> Random::epoch{1};
+
+void Random::seed(std::uint64_t seed) {
+    value = seed;
+    is_set = true;
+    epoch++;
+}
+
+std::uint64_t Random::seed() {
+    if (!is_set) {
+        static std::mutex mtx;
+        std::lock_guard<std::mutex> lock{mtx};
+        if (!is_set) {
+            std::random_device rd;
+            value = (static_cast<std::uint64_t>(rd()) << 32) | rd();
+            is_set = true;
+        }
+    }
+    return value;
+}
+
+Philox Random::stream(Domain domain, std::uint64_t id) {
+    // The top byte is the domain, the rest is the id
+    const std::uint64_t mask = (static_cast<std::uint64_t>(1) << 56) - 1;
+    return Philox{seed(), (static_cast<std::uint64_t>(domain) << 56) | (id & mask)};
+}
+
+Philox& Random::thread_stream() {
+    thread_local unsigned seen = 0;
+    thread_local Philox rng;
+
+    if (seen != epoch) {
+#ifdef _OPENMP
+        unsigned thread = omp_get_thread_num();
+#else
+        unsigned thread = 0;
+#endif
+        rng = stream(Domain::THREAD, thread);
+        seen = epoch;
+    }
+    return rng;
+}
@@ -0,0 +1,66 @@
+#ifndef RANDOM_H_
+#define RANDOM_H_
+
+#include "Philox.h"
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * The seed of the run and the random streams derived from it.
+ *
+ * Every stream is a Philox generator keyed by the seed, with a stream number
+ * made of a domain and an id. Streams never overlap and need no locking, so
+ * the same seed (and thread count) gives the same run no matter how the
+ * threads are scheduled.
+ */
+class Random {
+public:
+    /* What a stream is used for; keeps the ids of different uses apart */
+    enum class Domain : std::uint8_t {
+        /* The sequential decisions of the genetic algorithm */
+        GENETIC_ALGORITHM = 1,
+        /* Random genomes, by generation and individual */
+        INDIVIDUAL = 2,
+        /* VPR seeds, by job */
+        JOB = 3,
+        /* Anything else, by OpenMP thread */
+        THREAD = 4,
+        /* The design of the initial population */
+        SAMPLING = 5,
+        /* Where the migrants of the islands go */
+        MIGRATION = 6,
+        /* The order of a batch (see Batch) */
+        BATCH = 7
+    };
+
+    /**
+     * Sets the seed for all streams created afterwards. Thread streams are
+     * restarted.
+     */
+    static void seed(std::uint64_t value);
+
+    /**
+     * \return the seed of the run. Unless set, one is taken from
+     *         std::random_device the first time it is needed.
+     */
+    static std::uint64_t seed();
+
+    /**
+     * \return a new generator for the given use.
+     */
+    static Philox stream(Domain domain, std::uint64_t id);
+
+    /**
+     * \return the stream of the calling thread.
+     */
+    static Philox& thread_stream();
+
+private:
+    static std::atomic<std::uint64_t> value;
+    static std::atomic<bool> is_set;
+    /* Changed on every reseed so that thread streams restart */
+    static std::atomic<unsigned> epoch;
+};
+
+#endif /* end of include guard */
@@ -0,0 +1,125 @@
+#include "Reclaimer.h"
+
+#include <ftw.h>
+#include <sys/stat.h>
+#include <cstdio>
+
+namespace {
+
+int remove_entry(const char* path, const struct stat*, int, struct FTW*) {
+    // Keep going on errors; whatever is left is retried later
+    std::remove(path);
+    return 0;
+}
+
+}
+
+/* Constructors, Destructor, and Assignment operators {{{ */
+Reclaimer::Reclaimer(unsigned max_attempts,
+                     std::chrono::milliseconds retry_delay)
+    : max_attempts{max_attempts}
+    , retry_delay{retry_delay}
+    , mtx{}
+    , queued{}
+    , drained{}
+    , queue{}
+    , busy{false}
+    , stopping{false}
+    , failed{0}
+    , worker{}
+{ }
+
+// Destructor
+Reclaimer::~Reclaimer() {
+    {
+        std::lock_guard<std::mutex> lock{mtx};
+        stopping = true;
+    }
+    queued.notify_all();
+
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+/* }}} */
+
+void Reclaimer::reclaim(const std::string& dir) {
+    if (dir.empty()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{mtx};
+        queue.push_back(Entry{dir, 0, std::chrono::steady_clock::now()});
+        if (!worker.joinable()) {
+            worker = std::thread{&Reclaimer::run, this};
+        }
+    }
+    queued.notify_one();
+}
+
+void Reclaimer::wait() {
+    std::unique_lock<std::mutex> lock{mtx};
+    drained.wait(lock, [this]() { return queue.empty() && !busy; });
+}
+
+unsigned Reclaimer::failures() const {
+    std::lock_guard<std::mutex> lock{mtx};
+    return failed;
+}
+
+bool Reclaimer::remove_tree(const std::string& dir) {
+    // Children first, don't follow symbolic links
+    nftw(dir.c_str(), remove_entry, 16, FTW_DEPTH | FTW_PHYS);
+
+    struct stat st;
+    return lstat(dir.c_str(), &st) != 0;
+}
+
+/* Private methods */
+
+void Reclaimer::run() {
+    std::unique_lock<std::mutex> lock{mtx};
+    while (true) {
+        if (queue.empty()) {
+            drained.notify_all();
+            if (stopping) {
+                break;
+            }
+            queued.wait(lock);
+            continue;
+        }
+
+        Entry entry = queue.front();
+        queue.pop_front();
+
+        auto now = std::chrono::steady_clock::now();
+        if (entry.not_before > now) {
+            queue.push_back(entry);
+            // Sleep if the next entry is not due yet either
+            if (queue.front().not_before > now) {
+                queued.wait_until(lock, queue.front().not_before);
+            }
+            continue;
+        }
+
+        busy = true;
+        lock.unlock();
+        bool removed = remove_tree(entry.dir);
+        lock.lock();
+        busy = false;
+
+        if (removed) {
+            continue;
+        }
+
+        entry.attempts++;
+        if (entry.attempts < max_attempts) {
+            entry.not_before = std::chrono::steady_clock::now() + retry_delay;
+            queue.push_back(entry);
+        }
+        else {
+            failed++;
+        }
+    }
+}
@@ -0,0 +1,93 @@
+#ifndef RECLAIMER_H_
+#define RECLAIMER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * Removes directories in the background.
+ *
+ * Directories are queued with reclaim() and deleted one by one by a
+ * dedicated thread, so that the threads running ABC and VPR never wait for
+ * the file system. Removal is done in-process with nftw. A directory that
+ * cannot be removed completely (e.g. "Directory not empty" on gluster) is
+ * queued again and retried after a delay.
+ */
+class Reclaimer {
+public:
+    /* Constructors, Destructor, and Assignment operators {{{ */
+    /**
+     * \param[in] max_attempts how many times to try removing a directory
+     *            before giving up on it.
+     *
+     * \param[in] retry_delay how long to wait before trying again.
+     */
+    Reclaimer(unsigned max_attempts = 5,
+              std::chrono::milliseconds retry_delay = std::chrono::milliseconds{500});
+
+    // Copy constructor
+    Reclaimer(const Reclaimer& other) = delete;
+
+    /**
+     * Waits for the queued directories to be removed (or given up on) and
+     * stops the thread.
+     */
+    ~Reclaimer();
+
+    // Assignment operator
+    Reclaimer& operator=(const Reclaimer& other) = delete;
+    /* }}} */
+
+    /**
+     * Queues a directory for removal. Returns immediately.
+     * The thread is started on the first call.
+     */
+    void reclaim(const std::string& dir);
+
+    /**
+     * Blocks until the queue is empty.
+     */
+    void wait();
+
+    /**
+     * \return the number of directories that could not be removed.
+     */
+    unsigned failures() const;
+
+    /**
+     * Removes a directory and everything in it.
+     *
+     * \return true if the directory no longer exists.
+     */
+    static bool remove_tree(const std::string& dir);
+
+private:
+    struct Entry {
+        std::string dir;
+        unsigned attempts;
+        std::chrono::steady_clock::time_point not_before;
+    };
+
+    const unsigned max_attempts;
+    const std::chrono::milliseconds retry_delay;
+
+    mutable std::mutex mtx;
+    /* Signalled when an entry is queued or the reclaimer is stopping */
+    std::condition_variable queued;
+    /* Signalled when the queue becomes empty */
+    std::condition_variable drained;
+    std::deque<Entry> queue;
+    /* Whether the thread is working on an entry that is not in the queue */
+    bool busy;
+    bool stopping;
+    unsigned failed;
+    std::thread worker;
+
+    void run();
+};
+
+#endif /* end of include guard */
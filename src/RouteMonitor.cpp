@@ -0,0 +1,124 @@
+#include "RouteMonitor.h"
+
+#include <cstdio>
+#include <cstring>
+
+using Rule = RouteMonitor::Rule;
+
+unsigned RouteMonitor::abandoned_cnt = 0;
+double RouteMonitor::saved_seconds = 0;
+
+/* Constructors, Destructor, and Assignment operators {{{ */
+// Default constructor
+Rule::Rule()
+    : Rule(false, 15, 10, 0.05, 50)
+{ }
+
+Rule::Rule(bool enabled,
+           unsigned min_iterations,
+           unsigned window,
+           float min_improvement,
+           unsigned max_iterations)
+    : enabled{enabled}
+    , min_iterations{min_iterations}
+    , window{window}
+    , min_improvement{min_improvement}
+    , max_iterations{max_iterations}
+{ }
+
+// Default constructor
+RouteMonitor::RouteMonitor()
+    : RouteMonitor(Rule{})
+{ }
+
+RouteMonitor::RouteMonitor(const Rule& rule)
+    : rule{rule}
+    , in_table{false}
+    , stop{false}
+    , overused{}
+    , route_time{0}
+{ }
+/* }}} */
+
+bool RouteMonitor::feed(const char* line) {
+    if (stop) {
+        return false;
+    }
+
+    if (!in_table) {
+        in_table = std::strstr(line, "Overused RR Nodes") != nullptr;
+        return true;
+    }
+
+    // Anything that is not a row (separators, warnings) is ignored
+    if (!parse_iteration(line) || !rule.enabled) {
+        return true;
+    }
+
+    const unsigned iter = overused.size();
+    if (iter < rule.min_iterations || iter <= rule.window) {
+        return true;
+    }
+
+    double now = overused.back();
+    double before = overused[iter - 1 - rule.window];
+    if (now > 0 && now > (1 - rule.min_improvement) * before) {
+        stop = true;
+    }
+
+    return !stop;
+}
+
+bool RouteMonitor::abandoned() const {
+    return stop;
+}
+
+unsigned RouteMonitor::iterations() const {
+    return overused.size();
+}
+
+double RouteMonitor::saved_time() const {
+    if (!stop || overused.empty() || rule.max_iterations <= overused.size()) {
+        return 0;
+    }
+
+    double per_iteration = route_time / overused.size();
+    return per_iteration * (rule.max_iterations - overused.size());
+}
+
+void RouteMonitor::record() const {
+    if (!stop) {
+        return;
+    }
+
+    double saved = saved_time();
+#pragma omp atomic
+    abandoned_cnt++;
+#pragma omp atomic
+    saved_seconds += saved;
+}
+
+unsigned RouteMonitor::total_abandoned() {
+    return abandoned_cnt;
+}
+
+double RouteMonitor::total_saved_time() {
+    return saved_seconds;
+}
+
+/* Private methods */
+
+bool RouteMonitor::parse_iteration(const char* line) {
+    int iter;
+    double time, crit_path, over;
+    // e.g. "        3   0.04 sec  4.51737 ns   1.23e+02 (1.5543 %)"
+    if (std::sscanf(line, "%d %lf sec %lf ns %lf",
+                    &iter, &time, &crit_path, &over) != 4) {
+        return false;
+    }
+
+    overused.push_back(over);
+    route_time += time;
+
+    return true;
+}
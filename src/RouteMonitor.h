@@ -0,0 +1,115 @@
+#ifndef ROUTE_MONITOR_H_
+#define ROUTE_MONITOR_H_
+
+#include <string>
+#include <vector>
+
+/**
+ * Watches the router progress that VPR prints while it is running and
+ * decides whether routing is going to converge.
+ *
+ * VPR prints a table with one row per routing iteration:
+ *
+ * Iteration       Time   Crit Path     Overused RR Nodes
+ * --------- ---------- ----------- ---------------------
+ *         1   0.05 sec  4.51737 ns   8.77e+02 (11.0139 %)
+ *
+ * If the number of overused routing resources stops going down, the router
+ * will keep going until it reaches its maximum number of iterations and
+ * then give up anyway.
+ */
+class RouteMonitor {
+public:
+    /**
+     * When to give up on a route.
+     * Routing is abandoned once at least min_iterations have been run and the
+     * overused nodes have gone down by less than min_improvement (a fraction)
+     * over the last `window' iterations.
+     */
+    struct Rule {
+        /* Constructors, Destructor, and Assignment operators {{{ */
+        // Default constructor
+        Rule();
+
+        Rule(bool enabled,
+             unsigned min_iterations,
+             unsigned window,
+             float min_improvement,
+             unsigned max_iterations);
+        /* }}} */
+
+        bool enabled;
+        unsigned min_iterations;
+        unsigned window;
+        float min_improvement;
+        /* The maximum number of router iterations VPR runs (used to estimate
+         * the time saved) */
+        unsigned max_iterations;
+    };
+
+    /* Constructors, Destructor, and Assignment operators {{{ */
+    // Default constructor
+    RouteMonitor();
+
+    RouteMonitor(const Rule& rule);
+    /* }}} */
+
+    /**
+     * Looks at one line of VPR output.
+     *
+     * \param[in] line a line of output, with or without the newline.
+     *
+     * \return false if routing should be abandoned.
+     */
+    bool feed(const char* line);
+
+    /**
+     * \return true if feed() has returned false.
+     */
+    bool abandoned() const;
+
+    /**
+     * \return the number of router iterations seen so far.
+     */
+    unsigned iterations() const;
+
+    /**
+     * \return the number of seconds VPR would still have spent in the router
+     *         had it not been stopped (0 if it was not stopped).
+     */
+    double saved_time() const;
+
+    /**
+     * Adds the result of a monitored run to the totals of this process.
+     */
+    void record() const;
+
+    /**
+     * \return the number of routes abandoned in this process.
+     */
+    static unsigned total_abandoned();
+
+    /**
+     * \return the estimated router time saved in this process, in seconds.
+     */
+    static double total_saved_time();
+
+private:
+    static unsigned abandoned_cnt;
+    static double saved_seconds;
+
+    Rule rule;
+
+    /* Whether we are inside the table of router iterations */
+    bool in_table;
+    bool stop;
+
+    /* Overused nodes for each iteration */
+    std::vector<double> overused;
+    /* Total time spent in the router */
+    double route_time;
+
+    bool parse_iteration(const char* line);
+};
+
+#endif /* end of include guard */
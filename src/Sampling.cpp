@@ -0,0 +1,178 @@
+#include "Sampling.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+const unsigned Sampling::MAX_DIMENSIONS = 8;
+
+namespace {
+
+const unsigned BITS = 32;
+
+const unsigned PRIMES[] = {2, 3, 5, 7, 11, 13, 17, 19};
+
+/* Joe and Kuo (2008), new-joe-kuo-6.21201, for dimensions 2 to 8: degree
+ * of the primitive polynomial, its coefficients and the initial direction
+ * numbers */
+struct Direction {
+    unsigned s;
+    unsigned a;
+    std::array<unsigned, 5> m;
+};
+
+const Direction DIRECTIONS[] = {
+    {1, 0, {{1}}},
+    {2, 1, {{1, 3}}},
+    {3, 1, {{1, 3, 1}}},
+    {3, 2, {{1, 1, 1}}},
+    {4, 1, {{1, 1, 3, 3}}},
+    {4, 4, {{1, 3, 5, 13}}},
+    {5, 2, {{1, 1, 5, 5, 17}}}
+};
+
+/* The direction numbers v_1 .. v_32 of one dimension, scaled to 32 bits */
+std::array<std::uint32_t, BITS> direction_numbers(unsigned dimension) {
+    std::array<std::uint32_t, BITS> v;
+    if (dimension == 0) {
+        for (unsigned k = 0; k < BITS; k++) {
+            v[k] = static_cast<std::uint32_t>(1) << (BITS - 1 - k);
+        }
+        return v;
+    }
+
+    const Direction& d = DIRECTIONS[dimension - 1];
+    for (unsigned k = 0; k < BITS; k++) {
+        if (k < d.s) {
+            v[k] = d.m[k] << (BITS - 1 - k);
+            continue;
+        }
+        v[k] = v[k - d.s] ^ (v[k - d.s] >> d.s);
+        for (unsigned j = 1; j < d.s; j++) {
+            if ((d.a >> (d.s - 1 - j)) & 1) {
+                v[k] ^= v[k - j];
+            }
+        }
+    }
+    return v;
+}
+
+/* Position of the lowest zero bit */
+unsigned lowest_zero(unsigned i) {
+    unsigned c = 0;
+    while (i & 1) {
+        i >>= 1;
+        c++;
+    }
+    return c;
+}
+
+double uniform(Philox& rng) {
+    return std::generate_canonical<double, 53>(rng);
+}
+
+}
+
+Sampling::Method Sampling::parse_method(const std::string& name) {
+    if (name == "random") {
+        return Method::RANDOM;
+    }
+    if (name == "halton") {
+        return Method::HALTON;
+    }
+    if (name == "sobol") {
+        return Method::SOBOL;
+    }
+    if (name == "lhs") {
+        return Method::LATIN_HYPERCUBE;
+    }
+    throw std::invalid_argument{"Unknown sampling method " + name};
+}
+
+const char* Sampling::method_name(Method method) {
+    switch (method) {
+    case Method::RANDOM:
+        return "random";
+    case Method::HALTON:
+        return "halton";
+    case Method::SOBOL:
+        return "sobol";
+    case Method::LATIN_HYPERCUBE:
+        return "lhs";
+    }
+    return "unknown";
+}
+
+std::vector<std::vector<double>> Sampling::unit_points(Method method,
+                                                       unsigned count,
+                                                       unsigned dimensions,
+                                                       Philox& rng) {
+    if ((method == Method::HALTON || method == Method::SOBOL)
+        && dimensions > MAX_DIMENSIONS) {
+        throw std::invalid_argument{"Too many dimensions for "
+            + std::string{method_name(method)}};
+    }
+
+    std::vector<std::vector<double>> points(count, std::vector<double>(dimensions));
+    switch (method) {
+    case Method::RANDOM:
+        for (unsigned i = 0; i < count; i++) {
+            for (unsigned d = 0; d < dimensions; d++) {
+                points[i][d] = uniform(rng);
+            }
+        }
+        break;
+
+    case Method::HALTON:
+        // Cranley-Patterson rotation
+        for (unsigned d = 0; d < dimensions; d++) {
+            const double shift = uniform(rng);
+            for (unsigned i = 0; i < count; i++) {
+                double u = halton(i + 1, PRIMES[d]) + shift;
+                points[i][d] = u - std::floor(u);
+            }
+        }
+        break;
+
+    case Method::SOBOL:
+        // Gray code order, with a random digital shift that keeps the
+        // stratification
+        for (unsigned d = 0; d < dimensions; d++) {
+            const std::array<std::uint32_t, BITS> v = direction_numbers(d);
+            const std::uint32_t shift = static_cast<std::uint32_t>(rng());
+            std::uint32_t x = 0;
+            for (unsigned i = 0; i < count; i++) {
+                points[i][d] = (x ^ shift) / 4294967296.0;
+                x ^= v[lowest_zero(i)];
+            }
+        }
+        break;
+
+    case Method::LATIN_HYPERCUBE:
+        for (unsigned d = 0; d < dimensions; d++) {
+            std::vector<unsigned> strata(count);
+            std::iota(strata.begin(), strata.end(), 0);
+            std::shuffle(strata.begin(), strata.end(), rng);
+            for (unsigned i = 0; i < count; i++) {
+                points[i][d] = (strata[i] + uniform(rng)) / count;
+            }
+        }
+        break;
+    }
+    return points;
+}
+
+double Sampling::halton(unsigned index, unsigned base) {
+    double result = 0;
+    double f = 1;
+    while (index > 0) {
+        f /= base;
+        result += f * (index % base);
+        index /= base;
+    }
+    return result;
+}
@@ -0,0 +1,54 @@
+#ifndef SAMPLING_H_
+#define SAMPLING_H_
+
+#include "Philox.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * Designs for the initial population: points spread over the unit cube,
+ * which GenomeDescriptor::from_unit maps onto the grid of each gene.
+ *
+ * Halton and Sobol are randomised (a random shift and a random digital
+ * shift), and Latin hypercube draws its permutations, all from the given
+ * generator, so a design is reproduced by the seed and the method.
+ */
+class Sampling {
+public:
+    enum class Method {
+        /* Independent uniform draws */
+        RANDOM,
+        /* Halton sequence with bases 2, 3, 5, ... */
+        HALTON,
+        /* Sobol sequence with the Joe-Kuo direction numbers */
+        SOBOL,
+        /* One point in every stratum of every dimension */
+        LATIN_HYPERCUBE
+    };
+
+    /* Dimensions Halton and Sobol can do */
+    static const unsigned MAX_DIMENSIONS;
+
+    /**
+     * \return the method with the given name (random, halton, sobol or lhs).
+     *         Throws std::invalid_argument for anything else.
+     */
+    static Method parse_method(const std::string& name);
+
+    static const char* method_name(Method method);
+
+    /**
+     * \return count points in [0, 1)^dimensions, one vector per point.
+     *         Throws std::invalid_argument if there are too many dimensions.
+     */
+    static std::vector<std::vector<double>> unit_points(Method method,
+                                                        unsigned count,
+                                                        unsigned dimensions,
+                                                        Philox& rng);
+
+private:
+    static double halton(unsigned index, unsigned base);
+};
+
+#endif /* end of include guard */
@@ -0,0 +1,211 @@
+#include "Selection.h"
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <unordered_set>
+
+const unsigned Selection::MAX_ROUNDS = 8;
+
+/* Constructors, Destructor, and Assignment operators {{{ */
+// Default constructor
+Selection::AliasTable::AliasTable()
+    : prob{}
+    , alias{}
+{ }
+
+// Default constructor
+Selection::Selection()
+    : Selection(Scheme::ROULETTE)
+{ }
+
+Selection::Selection(Scheme scheme, unsigned tournament_size, bool by_position)
+    : how{scheme}
+    , tournament_size{std::max(tournament_size, 1u)}
+    , by_position{by_position}
+    , roulette{}
+{ }
+/* }}} */
+
+void Selection::AliasTable::build(const std::vector<double>& weights) {
+    const unsigned n = weights.size();
+    prob.assign(n, 1.0);
+    alias.resize(n);
+    if (n == 0) {
+        return;
+    }
+
+    double total = 0;
+    for (double w : weights) {
+        total += w;
+    }
+    if (total <= 0) {
+        // Uniform
+        for (unsigned i = 0; i < n; i++) {
+            alias[i] = i;
+        }
+        return;
+    }
+
+    // Vose's method: pair up the entries below and above the average
+    std::vector<double> scaled(n);
+    std::vector<unsigned> small, large;
+    for (unsigned i = 0; i < n; i++) {
+        scaled[i] = weights[i] * n / total;
+        (scaled[i] < 1.0 ? small : large).push_back(i);
+    }
+
+    while (!small.empty() && !large.empty()) {
+        unsigned s = small.back();
+        unsigned l = large.back();
+        small.pop_back();
+
+        prob[s] = scaled[s];
+        alias[s] = l;
+        scaled[l] -= 1.0 - scaled[s];
+        if (scaled[l] < 1.0) {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+
+    // Whatever is left is 1 up to rounding
+    for (unsigned i : large) {
+        prob[i] = 1.0;
+        alias[i] = i;
+    }
+    for (unsigned i : small) {
+        prob[i] = 1.0;
+        alias[i] = i;
+    }
+}
+
+unsigned Selection::AliasTable::sample(Philox& gen) const {
+    unsigned i = gen() % prob.size();
+    double u = std::generate_canonical<double, 53>(gen);
+    return u < prob[i] ? i : alias[i];
+}
+
+unsigned Selection::AliasTable::size() const {
+    return prob.size();
+}
+
+Selection::Scheme Selection::parse_scheme(const std::string& name) {
+    if (name == "roulette") {
+        return Scheme::ROULETTE;
+    }
+    if (name == "sus") {
+        return Scheme::SUS;
+    }
+    if (name == "tournament") {
+        return Scheme::TOURNAMENT;
+    }
+    throw std::invalid_argument{"Unknown selection scheme " + name};
+}
+
+std::uint64_t Selection::genome_key(const Population& population, unsigned i) {
+    return Architecture::Genome::key(population.genome(i));
+}
+
+bool Selection::needs_ranking() const {
+    return how != Scheme::TOURNAMENT || by_position;
+}
+
+std::vector<unsigned> Selection::select(const Population& population,
+                                        unsigned count,
+                                        Philox& gen) {
+    std::vector<unsigned> result;
+    if (population.empty() || count == 0) {
+        return result;
+    }
+
+    if (needs_ranking() && roulette.size() != population.size()) {
+        // Best first: weights n, n - 1, ..., 1
+        std::vector<double> weights(population.size());
+        for (unsigned i = 0; i < weights.size(); i++) {
+            weights[i] = weights.size() - i;
+        }
+        roulette.build(weights);
+    }
+
+    std::unordered_set<std::uint64_t> seen;
+    std::vector<unsigned> candidates;
+    const auto take = [&](unsigned i) {
+        if (population.non_failed(i)
+                && seen.insert(genome_key(population, i)).second) {
+            result.push_back(i);
+        }
+    };
+
+    for (unsigned round = 0; round < MAX_ROUNDS && result.size() < count; round++) {
+        candidates.clear();
+        draw(population, count - result.size(), gen, candidates);
+        for (unsigned i : candidates) {
+            if (result.size() == count) {
+                break;
+            }
+            take(i);
+        }
+    }
+
+    // Few distinct survivors left; take them in order rather than spinning
+    for (unsigned i = 0; i < population.size() && result.size() < count; i++) {
+        take(i);
+    }
+
+    return result;
+}
+
+Selection::Scheme Selection::scheme() const {
+    return how;
+}
+
+/* Private methods */
+
+void Selection::draw(const Population& population,
+                     unsigned count,
+                     Philox& gen,
+                     std::vector<unsigned>& out) {
+    const unsigned n = population.size();
+
+    switch (how) {
+    case Scheme::ROULETTE:
+        for (unsigned k = 0; k < count; k++) {
+            out.push_back(roulette.sample(gen));
+        }
+        break;
+
+    case Scheme::SUS: {
+        // Evenly spaced pointers over the cumulative rank weights
+        const double total = n * (n + 1.0) / 2;
+        const double step = total / count;
+        double pointer = std::generate_canonical<double, 53>(gen) * step;
+        double cumulative = 0;
+        unsigned i = 0;
+        for (unsigned k = 0; k < count; k++, pointer += step) {
+            while (i < n - 1 && cumulative + (n - i) <= pointer) {
+                cumulative += n - i;
+                i++;
+            }
+            out.push_back(i);
+        }
+        break;
+    }
+
+    case Scheme::TOURNAMENT:
+        for (unsigned k = 0; k < count; k++) {
+            unsigned best = gen() % n;
+            double best_fitness = by_position ? best : population.fitness(best);
+            for (unsigned t = 1; t < tournament_size; t++) {
+                unsigned other = gen() % n;
+                double fitness = by_position ? other : population.fitness(other);
+                if (fitness < best_fitness) {
+                    best = other;
+                    best_fitness = fitness;
+                }
+            }
+            out.push_back(best);
+        }
+        break;
+    }
+}
@@ -0,0 +1,126 @@
+#ifndef SELECTION_H_
+#define SELECTION_H_
+
+#include "Philox.h"
+#include "Population.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Picks the architectures to crossover/mutate from.
+ *
+ * Every scheme only looks at the survivors that are actually there, draws in
+ * constant time, and never picks two architectures with the same K, N and W.
+ * If random draws keep hitting duplicates, the remaining picks are taken in
+ * population order, so select() always finishes.
+ */
+class Selection {
+public:
+    enum class Scheme {
+        /* Rank based roulette wheel, one spin per pick */
+        ROULETTE,
+        /* Rank based stochastic universal sampling, one spin for all picks */
+        SUS,
+        /* Best of a few drawn uniformly */
+        TOURNAMENT
+    };
+
+    /**
+     * Walker's alias method: samples from a discrete distribution in O(1)
+     * after O(n) setup.
+     */
+    class AliasTable {
+    public:
+        // Default constructor
+        AliasTable();
+
+        /**
+         * Builds the table. Weights must not be negative and should not all
+         * be 0.
+         */
+        void build(const std::vector<double>& weights);
+
+        /**
+         * \return an index, with probability proportional to its weight.
+         */
+        unsigned sample(Philox& gen) const;
+
+        unsigned size() const;
+
+    private:
+        std::vector<double> prob;
+        std::vector<unsigned> alias;
+    };
+
+    /* Constructors, Destructor, and Assignment operators {{{ */
+    // Default constructor
+    Selection();
+
+    /**
+     * \param[in] scheme how to select.
+     *
+     * \param[in] tournament_size how many take part in each tournament.
+     *
+     * \param[in] by_position whether tournaments are won by the one that
+     *            comes first in the population instead of by fitness, for
+     *            populations ranked by something else.
+     */
+    Selection(Scheme scheme, unsigned tournament_size = 2,
+              bool by_position = false);
+    /* }}} */
+
+    /**
+     * \return the scheme with the given name (roulette, sus or tournament).
+     *         Throws std::invalid_argument for anything else.
+     */
+    static Scheme parse_scheme(const std::string& name);
+
+    /**
+     * \return a key that is the same for architectures with the same K, N
+     *         and W, and different otherwise.
+     */
+    static std::uint64_t genome_key(const Population& population, unsigned i);
+
+    /**
+     * \return true if the population must be fully sorted (best first)
+     *         before calling select().
+     */
+    bool needs_ranking() const;
+
+    /**
+     * Selects up to count distinct architectures that have not failed.
+     *
+     * \param[in] population the survivors, best first if needs_ranking().
+     *
+     * \return indices into population. Less than count if there are not
+     *         enough distinct architectures.
+     */
+    std::vector<unsigned> select(const Population& population,
+                                 unsigned count,
+                                 Philox& gen);
+
+    Scheme scheme() const;
+
+private:
+    /* How many rounds of random draws before filling in order */
+    static const unsigned MAX_ROUNDS;
+
+    Scheme how;
+    unsigned tournament_size;
+    bool by_position;
+
+    /* Rank weights; rebuilt when the number of survivors changes */
+    AliasTable roulette;
+
+    /**
+     * Draws candidates (possibly duplicates) according to the scheme.
+     */
+    void draw(const Population& population,
+              unsigned count,
+              Philox& gen,
+              std::vector<unsigned>& out);
+};
+
+#endif /* end of include guard */
@@ -0,0 +1,92 @@
+#include "Subprocess.h"
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+/* Constructors, Destructor, and Assignment operators {{{ */
+Subprocess::Subprocess(const std::string& command)
+    : pid{-1}
+    , out{nullptr}
+    , status{-1}
+    , waited{false}
+{
+    std::memset(&ru, 0, sizeof(ru));
+
+    // Close-on-exec so that commands started by other threads don't keep the
+    // write end open (which would prevent EOF)
+    int fds[2];
+    if (pipe2(fds, O_CLOEXEC) == -1) {
+        return;
+    }
+
+    pid = fork();
+    if (pid == 0) {
+        // Only async-signal-safe calls from here on
+        setpgid(0, 0);
+        dup2(fds[1], STDOUT_FILENO);
+        execl("/bin/sh", "sh", "-c", command.c_str(), static_cast<char*>(nullptr));
+        _exit(127);
+    }
+
+    close(fds[1]);
+    if (pid == -1) {
+        close(fds[0]);
+        return;
+    }
+    // Also set from the parent so that kill() works even if it is called
+    // before the child gets to run
+    setpgid(pid, pid);
+
+    out = fdopen(fds[0], "r");
+    if (out == nullptr) {
+        close(fds[0]);
+    }
+}
+
+// Destructor
+Subprocess::~Subprocess() {
+    wait();
+}
+/* }}} */
+
+FILE* Subprocess::output() const {
+    return out;
+}
+
+void Subprocess::kill() {
+    if (pid > 0 && !waited) {
+        ::kill(-pid, SIGKILL);
+    }
+}
+
+int Subprocess::wait() {
+    if (waited || pid <= 0) {
+        return status;
+    }
+
+    // Close our end first so that a command blocked on writing exits
+    if (out != nullptr) {
+        fclose(out);
+        out = nullptr;
+    }
+
+    pid_t ret;
+    do {
+        ret = wait4(pid, &status, 0, &ru);
+    } while (ret == -1 && errno == EINTR);
+
+    if (ret == -1) {
+        status = -1;
+    }
+    waited = true;
+
+    return status;
+}
+
+const struct rusage& Subprocess::usage() const {
+    return ru;
+}
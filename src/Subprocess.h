@@ -0,0 +1,65 @@
+#ifndef SUBPROCESS_H_
+#define SUBPROCESS_H_
+
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <cstdio>
+#include <string>
+
+/**
+ * A shell command whose standard output can be read like popen, but that
+ * can also be killed. The command runs in its own process group, so that
+ * killing it also kills whatever the shell has started (e.g. VPR).
+ */
+class Subprocess {
+public:
+    /* Constructors, Destructor, and Assignment operators {{{ */
+    /**
+     * Starts running the command with /bin/sh.
+     */
+    Subprocess(const std::string& command);
+
+    // Copy constructor
+    Subprocess(const Subprocess& other) = delete;
+
+    // Destructor
+    ~Subprocess();
+
+    // Assignment operator
+    Subprocess& operator=(const Subprocess& other) = delete;
+    /* }}} */
+
+    /**
+     * \return the standard output of the command, or nullptr if the command
+     *         could not be started.
+     */
+    FILE* output() const;
+
+    /**
+     * Kills the whole process group of the command.
+     */
+    void kill();
+
+    /**
+     * Waits for the command to exit. Called by the destructor if it is not
+     * called explicitly.
+     *
+     * \return the exit status as given by waitpid, or -1 on error.
+     */
+    int wait();
+
+    /**
+     * \return the resource usage of the command and its children. Only
+     *         valid after wait().
+     */
+    const struct rusage& usage() const;
+
+private:
+    pid_t pid;
+    FILE* out;
+    int status;
+    bool waited;
+    struct rusage ru;
+};
+
+#endif /* end of include guard */
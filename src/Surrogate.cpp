@@ -0,0 +1,143 @@
+#include "Surrogate.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+const unsigned Surrogate::NEIGHBOURS = 5;
+const unsigned Surrogate::MIN_TRAINING = 8;
+
+namespace {
+
+using Genome = Architecture::Genome;
+
+/* Average ranks, from 0 */
+std::vector<double> ranks(const std::vector<double>& values) {
+    std::vector<unsigned> order(values.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](unsigned a, unsigned b) {
+        return values[a] < values[b];
+    });
+
+    std::vector<double> result(values.size());
+    for (unsigned begin = 0; begin < order.size(); ) {
+        unsigned end = begin;
+        while (end < order.size() && values[order[end]] == values[order[begin]]) {
+            end++;
+        }
+        for (unsigned k = begin; k < end; k++) {
+            result[order[k]] = (begin + end - 1) / 2.0;
+        }
+        begin = end;
+    }
+    return result;
+}
+
+}
+
+/* Constructors, Destructor, and Assignment operators {{{ */
+// Default constructor
+Surrogate::Surrogate()
+    : points{}
+    , fitnesses{}
+    , index{}
+    , min_fitness{0}
+    , max_fitness{0}
+{ }
+/* }}} */
+
+void Surrogate::add(const Genome::Values& genome, double fitness) {
+    if (fitnesses.empty()) {
+        min_fitness = max_fitness = fitness;
+    }
+    min_fitness = std::min(min_fitness, fitness);
+    max_fitness = std::max(max_fitness, fitness);
+
+    auto found = index.find(Genome::key(genome));
+    if (found != index.end()) {
+        fitnesses[found->second] = fitness;
+        return;
+    }
+    index[Genome::key(genome)] = fitnesses.size();
+    fitnesses.push_back(fitness);
+    const std::vector<double> point = Genome::to_unit(genome);
+    points.insert(points.end(), point.begin(), point.end());
+}
+
+unsigned Surrogate::size() const {
+    return fitnesses.size();
+}
+
+bool Surrogate::contains(const Genome::Values& genome) const {
+    return index.count(Genome::key(genome)) != 0;
+}
+
+bool Surrogate::ready() const {
+    return size() >= MIN_TRAINING;
+}
+
+Surrogate::Prediction Surrogate::predict(const Genome::Values& genome) const {
+    if (fitnesses.empty()) {
+        return Prediction{0, std::numeric_limits<double>::infinity()};
+    }
+    // Known exactly
+    auto found = index.find(Genome::key(genome));
+    if (found != index.end()) {
+        return Prediction{fitnesses[found->second], 0};
+    }
+
+    const std::vector<double> point = Genome::to_unit(genome);
+    std::vector<std::pair<double, unsigned>> distances(fitnesses.size());
+    for (unsigned i = 0; i < fitnesses.size(); i++) {
+        double sum = 0;
+        for (unsigned d = 0; d < Genome::size; d++) {
+            const double diff = points[i * Genome::size + d] - point[d];
+            sum += diff * diff;
+        }
+        distances[i] = std::make_pair(std::sqrt(sum), i);
+    }
+    const unsigned k = std::min<unsigned>(NEIGHBOURS, distances.size());
+    std::partial_sort(distances.begin(), distances.begin() + k, distances.end());
+
+    double weights = 0, mean = 0;
+    for (unsigned j = 0; j < k; j++) {
+        const double w = 1 / distances[j].first;
+        weights += w;
+        mean += w * fitnesses[distances[j].second];
+    }
+    mean /= weights;
+
+    double spread = 0;
+    for (unsigned j = 0; j < k; j++) {
+        const double diff = fitnesses[distances[j].second] - mean;
+        spread += diff * diff / distances[j].first;
+    }
+    spread = std::sqrt(spread / weights);
+
+    // Far from anything run, the whole range is possible
+    return Prediction{mean, spread + distances[0].first * (max_fitness - min_fitness)};
+}
+
+double Surrogate::rank_correlation(const std::vector<double>& a,
+                                   const std::vector<double>& b) {
+    const unsigned n = std::min(a.size(), b.size());
+    if (n < 3) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    const std::vector<double> ra = ranks(std::vector<double>(a.begin(), a.begin() + n));
+    const std::vector<double> rb = ranks(std::vector<double>(b.begin(), b.begin() + n));
+    const double mean = (n - 1) / 2.0;
+    double cov = 0, va = 0, vb = 0;
+    for (unsigned i = 0; i < n; i++) {
+        cov += (ra[i] - mean) * (rb[i] - mean);
+        va += (ra[i] - mean) * (ra[i] - mean);
+        vb += (rb[i] - mean) * (rb[i] - mean);
+    }
+    if (va == 0 || vb == 0) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return cov / std::sqrt(va * vb);
+}
@@ -0,0 +1,79 @@
+#ifndef SURROGATE_H_
+#define SURROGATE_H_
+
+#include "Architecture.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * A k-nearest-neighbour model of the fitness, trained online on the
+ * architectures that have been run, to rank candidates before running them.
+ *
+ * Genomes are compared as points of the unit cube (see
+ * GenomeDescriptor::to_unit), so every gene counts the same whatever its
+ * range. A prediction is the inverse distance weighted mean of the nearest
+ * fitnesses, and its uncertainty grows with their spread and with the
+ * distance to the nearest one.
+ */
+class Surrogate {
+public:
+    struct Prediction {
+        double fitness;
+        double uncertainty;
+    };
+
+    /* Neighbours a prediction is made from */
+    static const unsigned NEIGHBOURS;
+    /* Architectures to train on before predict() means anything */
+    static const unsigned MIN_TRAINING;
+
+    /* Constructors, Destructor, and Assignment operators {{{ */
+    // Default constructor
+    Surrogate();
+    /* }}} */
+
+    /**
+     * Adds an architecture that has been run, or replaces its fitness if it
+     * is already there.
+     */
+    void add(const Architecture::Genome::Values& genome, double fitness);
+
+    /**
+     * \return the number of distinct architectures trained on.
+     */
+    unsigned size() const;
+
+    /**
+     * \return true if the architecture has been trained on.
+     */
+    bool contains(const Architecture::Genome::Values& genome) const;
+
+    /**
+     * \return true once there are MIN_TRAINING architectures.
+     */
+    bool ready() const;
+
+    Prediction predict(const Architecture::Genome::Values& genome) const;
+
+    /**
+     * \return Spearman's rank correlation of the two series (ties get their
+     *         average rank), or NaN if there are less than 3 pairs or either
+     *         series is constant.
+     */
+    static double rank_correlation(const std::vector<double>& a,
+                                   const std::vector<double>& b);
+
+private:
+    /* Unit cube coordinates of each architecture, one after the other */
+    std::vector<double> points;
+    std::vector<double> fitnesses;
+    /* Genome key to position */
+    std::unordered_map<std::uint64_t, unsigned> index;
+
+    double min_fitness;
+    double max_fitness;
+};
+
+#endif /* end of include guard */
@@ -0,0 +1,169 @@
+#include "Termination.h"
+
+#include <sys/resource.h>
+#include <sys/time.h>
+
+#include <unordered_set>
+
+namespace {
+
+double seconds(const struct timeval& tv) {
+    return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+}
+
+/* Constructors, Destructor, and Assignment operators {{{ */
+// Default constructor
+Termination::Criteria::Criteria()
+    : stagnation{0}
+    , min_diversity{0}
+    , wall_budget{0}
+    , cpu_budget{0}
+{ }
+
+Termination::Termination(const Criteria& criteria)
+    : criteria(criteria)
+    , start{std::chrono::steady_clock::now()}
+    , cpu_start{cpu_time()}
+    , why{Reason::NONE}
+    , best_arch{}
+    , best_fit{0}
+    , has_best_arch{false}
+    , since_improvement{0}
+    , mtx{}
+    , running{0}
+    , timed{0}
+    , total_wall{0}
+    , total_cpu{0}
+{ }
+/* }}} */
+
+Termination::Reason Termination::update(const Population& population) {
+    // The best of the ones that have results
+    bool found = false;
+    unsigned best = 0;
+    double fitness = 0;
+    for (unsigned i = 0; i < population.size(); i++) {
+        if (!population.already_run(i) || !population.non_failed(i)) {
+            continue;
+        }
+        double f = population.fitness(i);
+        if (!found || f < fitness) {
+            found = true;
+            best = i;
+            fitness = f;
+        }
+    }
+
+    if (found && (!has_best_arch || fitness < best_fit)) {
+        best_arch = population.to_architecture(best);
+        best_fit = fitness;
+        has_best_arch = true;
+        since_improvement = 0;
+    }
+    else {
+        since_improvement++;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{mtx};
+        // Used up, or too little left for another evaluation
+        why = out_of_budget(0);
+    }
+    if (why != Reason::NONE) {
+        return why;
+    }
+    if (criteria.stagnation > 0 && since_improvement >= criteria.stagnation) {
+        why = Reason::STAGNATION;
+    }
+    else if (criteria.min_diversity > 0 && population.size() > 1) {
+        std::unordered_set<std::uint64_t> distinct;
+        for (unsigned i = 0; i < population.size(); i++) {
+            distinct.insert(Architecture::Genome::key(population.genome(i)));
+        }
+        if (static_cast<double>(distinct.size()) / population.size()
+            < criteria.min_diversity) {
+            why = Reason::DIVERSITY;
+        }
+    }
+    return why;
+}
+
+Termination::Reason Termination::reason() const {
+    return why;
+}
+
+const char* Termination::reason_name(Reason reason) {
+    switch (reason) {
+    case Reason::NONE:
+        return "none";
+    case Reason::STAGNATION:
+        return "no improvement";
+    case Reason::DIVERSITY:
+        return "diversity collapse";
+    case Reason::WALL_BUDGET:
+        return "wall clock budget";
+    case Reason::CPU_BUDGET:
+        return "CPU budget";
+    }
+    return "unknown";
+}
+
+bool Termination::start_evaluation() {
+    std::lock_guard<std::mutex> lock{mtx};
+    if (out_of_budget(running) != Reason::NONE) {
+        return false;
+    }
+    running++;
+    return true;
+}
+
+void Termination::finished(double wall_time, double cpu_time) {
+    std::lock_guard<std::mutex> lock{mtx};
+    running--;
+    timed++;
+    total_wall += wall_time;
+    total_cpu += cpu_time;
+}
+
+bool Termination::has_best() const {
+    return has_best_arch;
+}
+
+const Architecture& Termination::best() const {
+    return best_arch;
+}
+
+double Termination::best_fitness() const {
+    return best_fit;
+}
+
+double Termination::wall_time() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now()
+                                         - start).count();
+}
+
+double Termination::cpu_time() {
+    struct rusage self, children;
+    getrusage(RUSAGE_SELF, &self);
+    getrusage(RUSAGE_CHILDREN, &children);
+    return seconds(self.ru_utime) + seconds(self.ru_stime)
+        + seconds(children.ru_utime) + seconds(children.ru_stime);
+}
+
+Termination::Reason Termination::out_of_budget(unsigned in_flight) const {
+    // Nothing to go by before the first evaluation finishes
+    const double wall = timed > 0 ? total_wall / timed : 0;
+    const double cpu = timed > 0 ? total_cpu / timed : 0;
+    if (criteria.wall_budget > 0
+        && wall_time() + wall > criteria.wall_budget) {
+        return Reason::WALL_BUDGET;
+    }
+    // The ones still running have not been counted by getrusage yet
+    if (criteria.cpu_budget > 0
+        && cpu_time() - cpu_start + (in_flight + 1) * cpu > criteria.cpu_budget) {
+        return Reason::CPU_BUDGET;
+    }
+    return Reason::NONE;
+}
@@ -0,0 +1,141 @@
+#ifndef TERMINATION_H_
+#define TERMINATION_H_
+
+#include "Architecture.h"
+#include "Population.h"
+
+#include <chrono>
+#include <mutex>
+
+/**
+ * Decides when a run is over, and whether there is still time for another
+ * evaluation.
+ *
+ * A run stops when the best fitness has not improved for a number of
+ * generations, when the population has collapsed to a few distinct
+ * architectures, or when the wall clock or CPU budget is used up. Evaluations
+ * are timed as they finish, and one that would not finish within the budget
+ * (going by the average so far) is not started at all. The best architecture
+ * seen is kept, so it can be reported even if the last generation lost it.
+ */
+class Termination {
+public:
+    /* Every criterion is off when 0 */
+    struct Criteria {
+        // Default constructor
+        Criteria();
+
+        /* Generations without improvement of the best fitness */
+        unsigned stagnation;
+        /* Smallest fraction of distinct architectures in the population */
+        double min_diversity;
+        /* Seconds since the start */
+        double wall_budget;
+        /* CPU seconds of this process and of ABC and VPR */
+        double cpu_budget;
+    };
+
+    enum class Reason {
+        NONE,
+        STAGNATION,
+        DIVERSITY,
+        WALL_BUDGET,
+        CPU_BUDGET
+    };
+
+    /* Constructors, Destructor, and Assignment operators {{{ */
+    /**
+     * Starts the clock.
+     */
+    Termination(const Criteria& criteria = Criteria{});
+
+    // Copy constructor
+    Termination(const Termination& other) = delete;
+
+    // Assignment operator
+    Termination& operator=(const Termination& other) = delete;
+    /* }}} */
+
+    /**
+     * Looks at the population after a generation has been run.
+     *
+     * \return why the run should stop, or NONE.
+     */
+    Reason update(const Population& population);
+
+    /**
+     * \return the reason given by the last update().
+     */
+    Reason reason() const;
+
+    static const char* reason_name(Reason reason);
+
+    /**
+     * \return true if an evaluation started now is expected to finish
+     *         within the budgets, counting the ones still running. If it
+     *         returns true, the caller must call finished() afterwards.
+     */
+    bool start_evaluation();
+
+    /**
+     * Records the time taken by an evaluation allowed by start_evaluation.
+     *
+     * \param[in] cpu_time the CPU time of ABC and VPR, in seconds.
+     */
+    void finished(double wall_time, double cpu_time);
+
+    /**
+     * \return true if the best architecture has been set by update().
+     */
+    bool has_best() const;
+
+    /**
+     * \return the best architecture seen by update().
+     */
+    const Architecture& best() const;
+
+    /**
+     * \return the fitness of best().
+     */
+    double best_fitness() const;
+
+    /**
+     * \return the seconds since the start.
+     */
+    double wall_time() const;
+
+    /**
+     * \return the CPU seconds of this process and its children so far.
+     */
+    static double cpu_time();
+
+private:
+    const Criteria criteria;
+    const std::chrono::steady_clock::time_point start;
+    /* CPU time at the start */
+    const double cpu_start;
+
+    Reason why;
+
+    Architecture best_arch;
+    double best_fit;
+    bool has_best_arch;
+    unsigned since_improvement;
+
+    /* Guards the evaluation timings below */
+    mutable std::mutex mtx;
+    unsigned running;
+    unsigned timed;
+    double total_wall;
+    double total_cpu;
+
+    /**
+     * Must be called with mtx held.
+     *
+     * \return which budget one more evaluation would exceed, with in_flight
+     *         others still running, or NONE.
+     */
+    Reason out_of_budget(unsigned in_flight) const;
+};
+
+#endif /* end of include guard */
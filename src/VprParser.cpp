@@ -0,0 +1,168 @@
+#include "VprParser.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#define CRIT_PATH "Final critical path:"
+#define LOGIC_AREA "Total used logic block area:"
+#define ROUTE_AREA "Total routing area:"
+#define PACK_TIME "Packing took"
+#define PLACE_TIME "Placement took"
+#define ROUTE_TIME "Routing took"
+#define ROUTE_ITERATIONS "Successfully routed after"
+#define WIRELENGTH "Total wirelength:"
+
+namespace {
+
+enum Metric : unsigned {
+    LOGIC_AREA_FOUND = 1,
+    ROUTE_AREA_FOUND = 2,
+    CRIT_PATH_FOUND = 4,
+    ALL_FOUND = 7
+};
+
+}
+
+/* Constructors, Destructor, and Assignment operators {{{ */
+VprParser::VprParser(RouteMonitor* monitor)
+    : monitor{monitor}
+    , logic_area{0}
+    , route_area{0}
+    , final_crit_path{0}
+    , found{0}
+    , pack{0}
+    , place{0}
+    , route{0}
+    , iterations{0}
+    , wires{0}
+{ }
+/* }}} */
+
+bool VprParser::feed(const char* line) {
+    if (monitor != nullptr && !monitor->feed(line)) {
+        return false;
+    }
+
+    // The first character after the indentation rules out most of the lines
+    // cheaply
+    const char* p = line;
+    while (*p == ' ' || *p == '\t') {
+        p++;
+    }
+
+    switch (*p) {
+    case 'T':
+        if (match(p, LOGIC_AREA, sizeof(LOGIC_AREA) - 1, logic_area)) {
+            found |= LOGIC_AREA_FOUND;
+        }
+        else if (match(p, ROUTE_AREA, sizeof(ROUTE_AREA) - 1, route_area)) {
+            found |= ROUTE_AREA_FOUND;
+        }
+        else {
+            match(p, WIRELENGTH, sizeof(WIRELENGTH) - 1, wires);
+        }
+        break;
+    case 'F':
+        if (match(p, CRIT_PATH, sizeof(CRIT_PATH) - 1, final_crit_path)) {
+            found |= CRIT_PATH_FOUND;
+        }
+        break;
+    case 'P':
+        if (!match(p, PACK_TIME, sizeof(PACK_TIME) - 1, pack)) {
+            match(p, PLACE_TIME, sizeof(PLACE_TIME) - 1, place);
+        }
+        break;
+    case 'R':
+        match(p, ROUTE_TIME, sizeof(ROUTE_TIME) - 1, route);
+        break;
+    case 'S':
+        match(p, ROUTE_ITERATIONS, sizeof(ROUTE_ITERATIONS) - 1, iterations);
+        break;
+    default:
+        break;
+    }
+
+    return true;
+}
+
+bool VprParser::parse(FILE* in) {
+    if (in == nullptr) {
+        return false;
+    }
+
+    char* line = nullptr;
+    size_t cap = 0;
+    while (getline(&line, &cap, in) != -1) {
+        if (!feed(line)) {
+            break;
+        }
+    }
+    std::free(line);
+
+    return complete();
+}
+
+bool VprParser::parse_file(const std::string& path) {
+    FILE* in = std::fopen(path.c_str(), "r");
+    if (in == nullptr) {
+        return false;
+    }
+    bool ret = parse(in);
+    std::fclose(in);
+    return ret;
+}
+
+bool VprParser::complete() const {
+    return found == ALL_FOUND;
+}
+
+double VprParser::area() const {
+    return logic_area + route_area;
+}
+
+double VprParser::crit_path() const {
+    return final_crit_path;
+}
+
+double VprParser::pack_time() const {
+    return pack;
+}
+
+double VprParser::place_time() const {
+    return place;
+}
+
+double VprParser::route_time() const {
+    return route;
+}
+
+unsigned VprParser::route_iterations() const {
+    if (iterations > 0) {
+        return static_cast<unsigned>(iterations);
+    }
+    // Routing did not succeed, but the monitor may have seen some iterations
+    return monitor != nullptr ? monitor->iterations() : 0;
+}
+
+double VprParser::wirelength() const {
+    return wires;
+}
+
+/* Private methods */
+
+bool VprParser::match(const char* line, const char* key, std::size_t key_len,
+                      double& value) {
+    if (std::strncmp(line, key, key_len) != 0) {
+        return false;
+    }
+
+    const char* start = line + key_len;
+    char* end;
+    double v = std::strtod(start, &end);
+    if (end == start) {
+        return false;
+    }
+
+    value = v;
+    return true;
+}
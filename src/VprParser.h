@@ -0,0 +1,107 @@
+#ifndef VPR_PARSER_H_
+#define VPR_PARSER_H_
+
+#include "RouteMonitor.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+
+/**
+ * Single pass scanner for the output of VPR.
+ * Lines are matched with plain string comparison and numbers are read with
+ * strtod, so lines can be fed as they come out of a running VPR, or read
+ * back from a saved log file.
+ */
+class VprParser {
+public:
+    /* Constructors, Destructor, and Assignment operators {{{ */
+    /**
+     * \param[in] monitor if not null, every line is also passed to the
+     *            monitor and parsing stops when the monitor gives up.
+     */
+    VprParser(RouteMonitor* monitor = nullptr);
+    /* }}} */
+
+    /**
+     * Looks at one line of output.
+     *
+     * \param[in] line a null-terminated line, with or without the newline.
+     *
+     * \return false if the monitor has given up.
+     */
+    bool feed(const char* line);
+
+    /**
+     * Reads the stream until the end or until the monitor gives up.
+     * Lines can be of any length.
+     *
+     * \return true if all metrics were found.
+     */
+    bool parse(FILE* in);
+
+    /**
+     * Same as parse but for a saved log file.
+     */
+    bool parse_file(const std::string& path);
+
+    /**
+     * \return true if all metrics have been found.
+     */
+    bool complete() const;
+
+    /**
+     * \return the total area (logic and routing) in minimum transistor units.
+     */
+    double area() const;
+
+    /**
+     * \return the critical path in ns.
+     */
+    double crit_path() const;
+
+    /**
+     * \return the time VPR reported for packing, placement and routing in
+     *         seconds, or 0 if the stage was not reached.
+     */
+    double pack_time() const;
+    double place_time() const;
+    double route_time() const;
+
+    /**
+     * \return the number of router iterations. If routing did not succeed,
+     *         the number of iterations seen by the monitor.
+     */
+    unsigned route_iterations() const;
+
+    /**
+     * \return the total wirelength in units of clb segments, or 0 if routing
+     *         did not succeed.
+     */
+    double wirelength() const;
+
+private:
+    RouteMonitor* monitor;
+
+    double logic_area;
+    double route_area;
+    double final_crit_path;
+    /* Bit set of the metrics found so far */
+    unsigned found;
+
+    double pack;
+    double place;
+    double route;
+    double iterations;
+    double wires;
+
+    /**
+     * If line starts with key, reads the number that follows it.
+     *
+     * \return true if the number was read.
+     */
+    static bool match(const char* line, const char* key, std::size_t key_len,
+                      double& value);
+};
+
+#endif /* end of include guard */
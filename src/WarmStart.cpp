@@ -0,0 +1,257 @@
+#include "WarmStart.h"
+
+#include "ArchiveReader.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+
+using Benchmark = Architecture::Benchmark;
+using Status = Benchmark::Status;
+using Result = Population::Result;
+
+namespace {
+
+/* Columns of the CSV that must be there */
+const char* const REQUIRED[] = {"K", "N", "W", "benchmark", "status", "area", "crit_path"};
+
+std::string base_name(const std::string& path) {
+    const std::size_t slash = path.rfind('/');
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+std::vector<std::string> split(const std::string& line) {
+    std::vector<std::string> fields{std::string{}};
+    for (char c : line) {
+        if (c == ',') {
+            fields.emplace_back();
+        }
+        else if (c != '\r') {
+            fields.back() += c;
+        }
+    }
+    return fields;
+}
+
+/* Finds the rows of the architectures, and fills in the first results of
+ * each of their benchmarks */
+class Collector {
+public:
+    Collector(const std::vector<Benchmark>& benchmarks)
+        : results{benchmarks}
+        , columns{}
+        , rows{}
+    {
+        for (unsigned b = 0; b < benchmarks.size(); b++) {
+            columns[base_name(benchmarks[b].get_filename())] = b;
+        }
+    }
+
+    void add(const Architecture::Genome::Values& genome,
+             const std::string& benchmark, const Result& result) {
+        // Not a result yet, or not a benchmark of this run
+        if (result.status == Status::NOT_RUN || result.status == Status::SCREENED
+            || result.status == Status::OUT_OF_BUDGET) {
+            return;
+        }
+        auto column = columns.find(base_name(benchmark));
+        if (column == columns.end() || !Architecture::Genome::valid(genome)) {
+            return;
+        }
+
+        const std::uint64_t key = Architecture::Genome::key(genome);
+        auto row = rows.find(key);
+        if (row == rows.end()) {
+            row = rows.emplace(key, results.add(genome)).first;
+        }
+        Result& r = results.result(row->second, column->second);
+        if (!r.is_populated) {
+            r = result;
+            r.is_populated = true;
+            if (r.status != Status::SUCCESS) {
+                r.area = Benchmark::FAILED;
+                r.crit_path = Benchmark::FAILED;
+            }
+        }
+    }
+
+    /* The architectures with results for every benchmark */
+    Population complete() const {
+        Population kept = results;
+        kept.clear();
+        for (unsigned i = 0; i < results.size(); i++) {
+            if (results.already_run(i)) {
+                kept.add(results, i);
+            }
+        }
+        return kept;
+    }
+
+private:
+    Population results;
+    /* Benchmark name to column */
+    std::unordered_map<std::string, unsigned> columns;
+    /* Genome key to row */
+    std::unordered_map<std::uint64_t, unsigned> rows;
+};
+
+double number(const std::string& text, unsigned line) {
+    char* end;
+    const double value = std::strtod(text.c_str(), &end);
+    if (text.empty() || *end != '\0') {
+        throw std::invalid_argument{"Line " + std::to_string(line)
+            + ": " + text + " is not a number"};
+    }
+    return value;
+}
+
+Status parse_status(const std::string& name, unsigned line) {
+    for (unsigned s = 0; s <= static_cast<unsigned>(Status::OUT_OF_BUDGET); s++) {
+        if (name == ArchiveReader::status_name(s)) {
+            return static_cast<Status>(s);
+        }
+    }
+    throw std::invalid_argument{"Line " + std::to_string(line)
+        + ": unknown status " + name};
+}
+
+}
+
+Population WarmStart::load(const std::string& path,
+                           const std::vector<Benchmark>& benchmarks) {
+    std::ifstream file{path, std::ios::binary};
+    if (!file) {
+        throw std::invalid_argument{"Cannot open " + path};
+    }
+    char magic[sizeof(EvaluationArchive::MAGIC)] = {};
+    file.read(magic, sizeof(magic));
+    if (file.gcount() != sizeof(magic)
+        || std::memcmp(magic, EvaluationArchive::MAGIC, sizeof(magic)) != 0) {
+        file.clear();
+        file.seekg(0);
+        return read_csv(file, benchmarks);
+    }
+
+    ArchiveReader reader{path};
+    if (!reader.ok()) {
+        throw std::invalid_argument{"Cannot read " + path
+            + " as an evaluation archive"};
+    }
+    Collector collector{benchmarks};
+    reader.for_each(ArchiveReader::Filter{},
+                    [&](const EvaluationArchive::Evaluation& e,
+                        const std::string& benchmark) {
+        Result result;
+        result.area = e.area;
+        result.crit_path = e.crit_path;
+        result.status = static_cast<Status>(e.status);
+        result.stats.pack_time = e.pack_time;
+        result.stats.place_time = e.place_time;
+        result.stats.route_time = e.route_time;
+        result.stats.route_iterations = e.route_iterations;
+        result.stats.wirelength = e.wirelength;
+        result.stats.peak_rss = e.peak_rss;
+        result.stats.cpu_time = e.cpu_time;
+        collector.add(Architecture::Genome::Values{{e.K, e.N, e.W}}, benchmark, result);
+    });
+    return collector.complete();
+}
+
+Population WarmStart::read_csv(std::istream& is,
+                               const std::vector<Benchmark>& benchmarks) {
+    std::string line;
+    if (!std::getline(is, line)) {
+        throw std::invalid_argument{"No results to start from"};
+    }
+    // Where each column is, by name
+    std::unordered_map<std::string, unsigned> header;
+    std::vector<std::string> names = split(line);
+    for (unsigned c = 0; c < names.size(); c++) {
+        header[names[c]] = c;
+    }
+    for (const char* name : REQUIRED) {
+        if (header.count(name) == 0) {
+            throw std::invalid_argument{"The results have no "
+                + std::string{name} + " column"};
+        }
+    }
+    auto optional = [&](const std::vector<std::string>& fields,
+                        const char* name, unsigned line_number) {
+        auto found = header.find(name);
+        return found == header.end() || found->second >= fields.size()
+            ? 0.0 : number(fields[found->second], line_number);
+    };
+
+    Collector collector{benchmarks};
+    for (unsigned line_number = 2; std::getline(is, line); line_number++) {
+        if (line.empty() || line == "\r") {
+            continue;
+        }
+        std::vector<std::string> fields = split(line);
+        if (fields.size() < names.size()) {
+            throw std::invalid_argument{"Line " + std::to_string(line_number)
+                + " has too few columns"};
+        }
+        auto field = [&](const char* name) -> const std::string& {
+            return fields[header[name]];
+        };
+
+        Architecture::Genome::Values genome;
+        for (unsigned g = 0; g < genome.size(); g++) {
+            const double value = number(field(REQUIRED[g]), line_number);
+            genome[g] = value < 0 ? 0 : static_cast<unsigned>(value);
+        }
+        Result result;
+        result.status = parse_status(field("status"), line_number);
+        result.area = number(field("area"), line_number);
+        result.crit_path = number(field("crit_path"), line_number);
+        result.stats.pack_time = optional(fields, "pack_time", line_number);
+        result.stats.place_time = optional(fields, "place_time", line_number);
+        result.stats.route_time = optional(fields, "route_time", line_number);
+        result.stats.route_iterations = optional(fields, "route_iters", line_number);
+        result.stats.wirelength = optional(fields, "wirelength", line_number);
+        result.stats.peak_rss = optional(fields, "peak_rss_kb", line_number);
+        result.stats.cpu_time = optional(fields, "cpu_time", line_number);
+        collector.add(genome, field("benchmark"), result);
+    }
+    return collector.complete();
+}
+
+std::vector<unsigned> WarmStart::best(const Population& results, unsigned count) {
+    std::vector<unsigned> order;
+    const unsigned B = results.num_benchmarks();
+    std::vector<double> crit_path(B, 0), area(B, 0);
+    for (unsigned i = 0; i < results.size(); i++) {
+        if (!results.non_failed(i)) {
+            continue;
+        }
+        order.push_back(i);
+        for (unsigned b = 0; b < B; b++) {
+            crit_path[b] += results.result(i, b).crit_path;
+            area[b] += results.result(i, b).area;
+        }
+    }
+
+    // Dividing by the sums ranks the same as dividing by the averages
+    std::vector<double> score(results.size(), 0);
+    for (unsigned i : order) {
+        for (unsigned b = 0; b < B; b++) {
+            if (crit_path[b] > 0) {
+                score[i] += results.result(i, b).crit_path / crit_path[b];
+            }
+            if (area[b] > 0) {
+                score[i] += results.result(i, b).area / area[b];
+            }
+        }
+    }
+    count = std::min<unsigned>(count, order.size());
+    std::partial_sort(order.begin(), order.begin() + count, order.end(),
+                      [&score](unsigned a, unsigned b) {
+        return score[a] != score[b] ? score[a] < score[b] : a < b;
+    });
+    order.resize(count);
+    return order;
+}
@@ -0,0 +1,49 @@
+#ifndef WARM_START_H_
+#define WARM_START_H_
+
+#include "Architecture.h"
+#include "Population.h"
+
+#include <istream>
+#include <string>
+#include <vector>
+
+/**
+ * Results of earlier runs to start a new one from, instead of a first
+ * generation made from scratch.
+ *
+ * Results are read from an evaluation archive (see EvaluationArchive) or from
+ * the CSV written by fp-GA-archive or by a batch (see Batch). Benchmarks are
+ * matched by file name without the directory, so runs from other machines can
+ * be used. An architecture is only kept if there are results for every
+ * benchmark of the new run, taking the first results of each benchmark when
+ * it has been run more than once.
+ */
+class WarmStart {
+public:
+    /**
+     * \return the results read from a file, one row per architecture, with
+     *         the given benchmarks as columns. Throws std::invalid_argument
+     *         if the file cannot be read.
+     */
+    static Population load(const std::string& path,
+                           const std::vector<Architecture::Benchmark>& benchmarks);
+
+    /**
+     * Same as load for the CSV format.
+     */
+    static Population read_csv(std::istream& is,
+                               const std::vector<Architecture::Benchmark>& benchmarks);
+
+    /**
+     * Ranks the architectures that did not fail by the average of their
+     * critical path and area, each divided by the average of its benchmark
+     * over these architectures. This is Architecture::fitness with that
+     * average as the reference, and it does not need a reference run.
+     *
+     * \return the rows of the best count, best first.
+     */
+    static std::vector<unsigned> best(const Population& results, unsigned count);
+};
+
+#endif /* end of include guard */
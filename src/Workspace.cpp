@@ -0,0 +1,166 @@
+#include "Workspace.h"
+
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <cstdlib>
+#include <fstream>
+#include <vector>
+
+/* Constructors, Destructor, and Assignment operators {{{ */
+Workspace::Workspace()
+    : dir{absolute(".")}
+    , template_path{"../arch_template.xml"}
+    , owned{false}
+    , staged{}
+    , reclaimer{}
+    , memfd{false}
+    , memfd_rejected{false}
+{ }
+
+Workspace::Workspace(const std::string& scratch_root,
+                     const std::string& arch_template)
+    : dir{}
+    , template_path{arch_template}
+    , owned{false}
+    , staged{}
+    , reclaimer{}
+    , memfd{false}
+    , memfd_rejected{false}
+{
+    // VPR is run from within the job directories, so the paths given to it
+    // must not be relative
+    std::string path = absolute(scratch_root) + "/fp-GA-architecture.XXXXXX";
+    std::vector<char> buf{path.begin(), path.end()};
+    buf.push_back('\0');
+
+    if (mkdtemp(buf.data()) != nullptr) {
+        dir = std::string{buf.data()};
+        owned = true;
+    }
+}
+
+// Destructor
+Workspace::~Workspace() {
+    if (owned) {
+        reclaimer.reclaim(dir);
+    }
+    reclaimer.wait();
+}
+/* }}} */
+
+std::string Workspace::default_root() {
+    const char* tmpdir = std::getenv("TMPDIR");
+    if (tmpdir != nullptr && tmpdir[0] != '\0') {
+        return std::string{tmpdir};
+    }
+    return "/dev/shm";
+}
+
+bool Workspace::ok() const {
+    return !dir.empty();
+}
+
+bool Workspace::stage(const std::vector<std::string>& inputs) {
+    if (!ok()) {
+        return false;
+    }
+
+    std::string path = copy_in(template_path, dir);
+    if (path.empty()) {
+        return false;
+    }
+    template_path = path;
+
+    for (unsigned i = 0; i < inputs.size(); i++) {
+        if (staged.count(inputs[i]) != 0) {
+            continue;
+        }
+        // Each in its own directory in case the names are the same
+        path = copy_in(inputs[i], dir + "/input_" + std::to_string(i));
+        if (path.empty()) {
+            return false;
+        }
+        staged[inputs[i]] = path;
+    }
+
+    return true;
+}
+
+const std::string& Workspace::input(const std::string& path) const {
+    auto it = staged.find(path);
+    return it != staged.end() ? it->second : path;
+}
+
+const std::string& Workspace::arch_template() const {
+    return template_path;
+}
+
+std::string Workspace::make_job_dir(const std::string& name) const {
+    if (!ok()) {
+        return std::string{};
+    }
+
+    std::string path = dir + '/' + name + ".XXXXXX";
+    std::vector<char> buf{path.begin(), path.end()};
+    buf.push_back('\0');
+
+    if (mkdtemp(buf.data()) == nullptr) {
+        return std::string{};
+    }
+    return std::string{buf.data()};
+}
+
+void Workspace::reclaim(const std::string& dir) const {
+    reclaimer.reclaim(dir);
+}
+
+unsigned Workspace::reclaim_failures() const {
+    return reclaimer.failures();
+}
+
+const std::string& Workspace::root() const {
+    return dir;
+}
+
+void Workspace::set_memfd(bool enabled) {
+    memfd = enabled;
+}
+
+bool Workspace::use_memfd() const {
+    return memfd && !memfd_rejected;
+}
+
+void Workspace::reject_memfd() const {
+    memfd_rejected = true;
+}
+
+/* Private methods */
+
+std::string Workspace::absolute(const std::string& path) {
+    if (!path.empty() && path[0] == '/') {
+        return path;
+    }
+
+    char cwd[4096];
+    if (getcwd(cwd, sizeof(cwd)) == nullptr) {
+        return path;
+    }
+    return path == "." ? std::string{cwd} : std::string{cwd} + '/' + path;
+}
+
+std::string Workspace::copy_in(const std::string& path,
+                               const std::string& subdir) {
+    mkdir(subdir.c_str(), 0700);
+    std::string dest = subdir + '/' + path.substr(path.rfind('/') + 1);
+
+    std::ifstream is(path, std::ios::binary);
+    std::ofstream os(dest, std::ios::binary);
+    if (!is || !os) {
+        return std::string{};
+    }
+    os << is.rdbuf();
+    os.close();
+
+    return os ? dest : std::string{};
+}
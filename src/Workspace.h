@@ -0,0 +1,145 @@
+#ifndef WORKSPACE_H_
+#define WORKSPACE_H_
+
+#include "Reclaimer.h"
+
+#include <atomic>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Where the files needed to evaluate architectures live.
+ *
+ * Everything is kept in a directory that is unique to this process under a
+ * scratch root, which should be on local storage (e.g. /dev/shm). The
+ * architecture template and the benchmarks are copied there once, so that
+ * ABC and VPR never touch the (possibly networked) file system the program
+ * was started from. Job directories are removed in the background by a
+ * Reclaimer, and the workspace itself when it is destroyed.
+ */
+class Workspace {
+public:
+    /* Constructors, Destructor, and Assignment operators {{{ */
+    /**
+     * Creates a workspace that uses the current directory and reads the
+     * template from ../arch_template.xml, without staging anything.
+     */
+    Workspace();
+
+    /**
+     * Creates a unique directory for this process under the given root.
+     *
+     * \param[in] scratch_root the directory to create the workspace in.
+     *
+     * \param[in] arch_template path to the architecture template.
+     */
+    Workspace(const std::string& scratch_root,
+              const std::string& arch_template);
+
+    // Copy constructor
+    Workspace(const Workspace& other) = delete;
+
+    // Destructor
+    ~Workspace();
+
+    // Assignment operator
+    Workspace& operator=(const Workspace& other) = delete;
+    /* }}} */
+
+    /**
+     * \return $TMPDIR if set, /dev/shm otherwise.
+     */
+    static std::string default_root();
+
+    /**
+     * \return false if the directory for this process could not be created.
+     */
+    bool ok() const;
+
+    /**
+     * Copies the template and the given input files into the workspace.
+     *
+     * \param[in] inputs paths to the benchmarks.
+     *
+     * \return false if any of the files could not be copied.
+     */
+    bool stage(const std::vector<std::string>& inputs);
+
+    /**
+     * \return the staged copy of an input file, or the path itself if it
+     *         was not staged.
+     */
+    const std::string& input(const std::string& path) const;
+
+    /**
+     * \return the path to the (staged) architecture template.
+     */
+    const std::string& arch_template() const;
+
+    /**
+     * Creates a new directory that no other job uses.
+     *
+     * \param[in] name prefix of the directory name.
+     *
+     * \return path to the directory, or an empty string on failure.
+     */
+    std::string make_job_dir(const std::string& name) const;
+
+    /**
+     * Queues a job directory for removal in the background.
+     */
+    void reclaim(const std::string& dir) const;
+
+    /**
+     * \return the number of directories that could not be removed.
+     */
+    unsigned reclaim_failures() const;
+
+    /**
+     * \return the directory of this workspace.
+     */
+    const std::string& root() const;
+
+    /**
+     * Whether architecture files should be handed to ABC and VPR as sealed
+     * in-memory files (memfd) instead of being written to the job directory.
+     */
+    void set_memfd(bool enabled);
+
+    /**
+     * \return true if memfd is enabled and no tool has rejected it so far.
+     */
+    bool use_memfd() const;
+
+    /**
+     * Falls back to regular files for all later architectures. Called when
+     * ABC or VPR could not read an architecture through its memfd path.
+     */
+    void reject_memfd() const;
+
+private:
+    std::string dir;
+    std::string template_path;
+    /* Whether dir was created by (and should be removed by) us */
+    bool owned;
+    /* Original path to staged path */
+    std::unordered_map<std::string, std::string> staged;
+    mutable Reclaimer reclaimer;
+    bool memfd;
+    mutable std::atomic<bool> memfd_rejected;
+
+    /**
+     * \return path prefixed with the current directory if it is relative.
+     */
+    static std::string absolute(const std::string& path);
+
+    /**
+     * Copies a file into subdir (created if needed), keeping its name.
+     *
+     * \return the path to the copy, or an empty string on failure.
+     */
+    std::string copy_in(const std::string& path, const std::string& subdir);
+};
+
+#endif /* end of include guard */
@@ -1,10 +1,21 @@
 #include "Architecture.h"
+#include "Batch.h"
+#include "EvaluationArchive.h"
 #include "GeneticAlgorithm.h"
+#include "IslandModel.h"
+#include "Random.h"
+#include "Sampling.h"
+#include "Termination.h"
+#include "WarmStart.h"
 
 #include "cxxopts.hpp"
 
 #include <iostream>
 #include <csignal>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
 
 bool keep_going = true;
 
@@ -24,6 +35,40 @@ int main(int argc, char* argv[]) {
     float mutation_occurrence_rate = 0.05;
     float mutation_amount = 0.05;
     float crossover_occurrence_rate = 0.05;
+    bool prescreen = false;
+    float prescreen_slack = 0.8;
+    RouteMonitor::Rule route_rule;
+    std::string selection_scheme = "roulette";
+    unsigned tournament_size = 2;
+    std::string crossover_operator = "xor";
+    std::string mutation_operator = "gaussian";
+    std::string mutation_adaptation = "none";
+    std::string initial_sampling = "random";
+    unsigned local_search_elites = 0;
+    unsigned local_search_budget = 6;
+    unsigned surrogate_pool = 0;
+    std::string objective = "weighted";
+    std::string engine = "genetic";
+    unsigned num_islands = 1;
+    IslandModel::Migration migration;
+    migration.interval = 5;
+    std::string migration_topology = "ring";
+    std::string scratch_dir = Workspace::default_root();
+    std::string arch_template = "../arch_template.xml";
+    bool memfd_arch = false;
+    std::string archive_path;
+    std::uint64_t seed = 0;
+    Termination::Criteria criteria;
+    double wall_budget_hours = 0;
+    double cpu_budget_hours = 0;
+    std::string reference_path;
+    std::string baseline;
+    std::string warm_start;
+    unsigned warm_start_count = 0;
+    std::string evaluate_file;
+    std::string sweep;
+    std::string batch_order = "given";
+    std::string shard = "0/1";
     bool show_help = false;
     bool output_csv = false;
 
@@ -46,6 +91,110 @@ int main(int argc, char* argv[]) {
          cxxopts::value(mutation_amount))
         ("c,crossover-occurrence", "The probability of crossover to occur",
          cxxopts::value(crossover_occurrence_rate))
+        ("selection-scheme", "How to select architectures to crossover/"
+         "mutate from: roulette, sus or tournament",
+         cxxopts::value(selection_scheme))
+        ("tournament-size", "Architectures taking part in each tournament",
+         cxxopts::value(tournament_size))
+        ("crossover-operator", "How genes are crossed: xor, blend or sbx",
+         cxxopts::value(crossover_operator))
+        ("mutation-operator", "How genes are mutated: gaussian, polynomial "
+         "or discrete-gaussian", cxxopts::value(mutation_operator))
+        ("mutation-adaptation", "Let each architecture carry its own "
+         "mutation amount and occurrence rate, starting from -a and -o: "
+         "none, one-fifth (success rule) or log-normal",
+         cxxopts::value(mutation_adaptation))
+        ("initial-sampling", "How the first generation is spread over K, N "
+         "and W: random, halton, sobol or lhs (Latin hypercube)",
+         cxxopts::value(initial_sampling))
+        ("engine", "What makes each generation: genetic (selection, "
+         "crossover and mutation) or bayesian (Gaussian process Bayesian "
+         "optimisation, one batch of --population-size per generation)",
+         cxxopts::value(engine))
+        ("objective", "What to optimise: weighted (the average of the "
+         "critical path and area ratios) or pareto (NSGA-II, printing every "
+         "trade-off found at the end)", cxxopts::value(objective))
+        ("islands", "Number of populations of --population-size each, "
+         "evolving apart and exchanging their best architectures",
+         cxxopts::value(num_islands))
+        ("migration-interval", "Generations between exchanges between "
+         "islands (0 for none)", cxxopts::value(migration.interval))
+        ("migrants", "How many of its best architectures each island sends",
+         cxxopts::value(migration.migrants))
+        ("migration-topology", "Where they go: ring (the next island), full "
+         "(every other island) or random", cxxopts::value(migration_topology))
+        ("surrogate-pool", "Make this many candidates each generation and "
+         "only run the ones a nearest-neighbour model of the results so far "
+         "likes best or knows least about (0 for all)",
+         cxxopts::value(surrogate_pool))
+        ("reference", "Measure against earlier results (an --archive file, "
+         "or the CSV of fp-GA-archive or of a batch): those of the --baseline, "
+         "or else of the first architecture there that did not fail",
+         cxxopts::value(reference_path))
+        ("baseline", "Measure against this architecture, run with the first "
+         "generation unless --reference has it: kK_NN[_WW] (W=100 if not "
+         "given, e.g. k6_N10) or K,N,W (default: the first architecture of "
+         "the first generation that does not fail)", cxxopts::value(baseline))
+        ("warm-start", "Start from the best architectures of earlier results "
+         "(an --archive file, or the CSV of fp-GA-archive or of a batch), "
+         "without running them again", cxxopts::value(warm_start))
+        ("warm-start-count", "How many architectures to start from (default: "
+         "half of the population)", cxxopts::value(warm_start_count))
+        ("local-search-elites", "How many of the best get their neighbours "
+         "(K and N +-1, W +-2) tried every generation",
+         cxxopts::value(local_search_elites))
+        ("local-search-budget", "How many new architectures the local "
+         "search may run per generation", cxxopts::value(local_search_budget))
+        ("prescreen", "Skip candidates that the analytic model estimates to "
+         "be worse than every survivor, or too narrow to route",
+         cxxopts::value(prescreen))
+        ("prescreen-slack", "How much better than the analytic model's "
+         "estimates VPR may do, on the ratios and on the channel width "
+         "(smaller is more conservative)",
+         cxxopts::value(prescreen_slack))
+        ("kill-unroutable", "Stop VPR when routing is not converging",
+         cxxopts::value(route_rule.enabled))
+        ("route-min-iterations", "Router iterations before a route may be "
+         "stopped", cxxopts::value(route_rule.min_iterations))
+        ("route-window", "Router iterations to look back when checking "
+         "for convergence", cxxopts::value(route_rule.window))
+        ("route-min-improvement", "Fraction the overused nodes must go down "
+         "by within the window", cxxopts::value(route_rule.min_improvement))
+        ("max-router-iterations", "Maximum number of router iterations "
+         "VPR runs", cxxopts::value(route_rule.max_iterations))
+        ("scratch-dir", "Local directory to run ABC and VPR in",
+         cxxopts::value(scratch_dir))
+        ("arch-template", "Path to the architecture template",
+         cxxopts::value(arch_template))
+        ("memfd-arch", "Pass architecture files to ABC and VPR in memory "
+         "(falls back to files if they cannot read them)",
+         cxxopts::value(memfd_arch))
+        ("archive", "Record every evaluation in this binary file (see "
+         "fp-GA-archive)", cxxopts::value(archive_path))
+        ("stagnation", "Stop after this many generations without a better "
+         "architecture", cxxopts::value(criteria.stagnation))
+        ("min-diversity", "Stop when the fraction of distinct architectures "
+         "in the population falls below this", cxxopts::value(criteria.min_diversity))
+        ("wall-budget", "Stop after this many hours, without starting "
+         "evaluations that would not finish in time",
+         cxxopts::value(wall_budget_hours))
+        ("cpu-budget", "Same as --wall-budget for CPU hours, including ABC "
+         "and VPR", cxxopts::value(cpu_budget_hours))
+        ("seed", "Seed for every random decision, VPR seeds included; a "
+         "run is replayed by giving the same seed and thread count",
+         cxxopts::value(seed))
+        ("evaluate-file", "Only run the architectures listed in this file "
+         "(K,N,W per line, or the output of fp-GA-archive or of an earlier "
+         "batch) and print their results as they finish",
+         cxxopts::value(evaluate_file))
+        ("sweep", "Only run every architecture of a grid given as "
+         "K=a:b:s,N=a:b:s,W=a:b:s (step and end optional), like "
+         "--evaluate-file", cxxopts::value(sweep))
+        ("order", "Order of --evaluate-file and --sweep: given, shuffle or "
+         "cost (longest expected runs first)", cxxopts::value(batch_order))
+        ("shard", "Only run every n-th architecture of --evaluate-file and "
+         "--sweep, starting from the i-th, given as i/n",
+         cxxopts::value(shard))
         ("csv", "Output in CSV format",
          cxxopts::value(output_csv))
         ("h,help", "Show this help",
@@ -57,6 +206,12 @@ int main(int argc, char* argv[]) {
         return 0;
     }
 
+    // Batch results are always CSV, so nothing else goes to stdout
+    const bool batch_mode = !evaluate_file.empty() || !sweep.empty();
+    if (batch_mode) {
+        output_csv = true;
+    }
+
     if (argc < 3) {
         std::cerr << "Need at least one benchmark" << std::endl;
         std::cerr << options.help() << std::endl;
@@ -69,9 +224,31 @@ int main(int argc, char* argv[]) {
     }
     // Add benchmarks
     std::vector<Architecture::Benchmark> benchmarks;
+    std::vector<std::string> inputs;
     for (int i = 2; i < argc; i++) {
         benchmarks.emplace_back(argv[i]);
+        inputs.emplace_back(argv[i]);
+    }
+
+    // Copy everything ABC and VPR need to local storage once
+    auto workspace = std::make_shared<Workspace>(scratch_dir, arch_template);
+    if (!workspace->ok()) {
+        std::cerr << "Cannot create a directory in " << scratch_dir << std::endl;
+        return 1;
+    }
+    if (!workspace->stage(inputs)) {
+        std::cerr << "Cannot copy the architecture template or benchmarks to "
+            << workspace->root() << std::endl;
+        return 1;
+    }
+    workspace->set_memfd(memfd_arch);
+
+    // Before anything draws a random number
+    if (options.count("seed") != 0) {
+        Random::seed(seed);
     }
+    (output_csv ? std::cerr : std::cout) << "Seed: " << Random::seed()
+        << std::endl;
 
     GeneticAlgorithm::Params params{
         num_population,
@@ -81,13 +258,203 @@ int main(int argc, char* argv[]) {
         mutation_amount,
         crossover_occurrence_rate
     };
-    GeneticAlgorithm ga{params, vtr_path, benchmarks};
+    params.prescreen = prescreen;
+    params.prescreen_slack = prescreen_slack;
+    params.route_rule = route_rule;
+    try {
+        params.selection = Selection::parse_scheme(selection_scheme);
+        params.operators = Operators{
+            Operators::parse_crossover(crossover_operator),
+            Operators::parse_mutation(mutation_operator)
+        };
+        params.adaptation = GeneticAlgorithm::parse_adaptation(mutation_adaptation);
+        params.initial_sampling = Sampling::parse_method(initial_sampling);
+        params.objective = GeneticAlgorithm::parse_objective(objective);
+        params.engine = GeneticAlgorithm::parse_engine(engine);
+        migration.topology = IslandModel::parse_topology(migration_topology);
+    }
+    catch (const std::invalid_argument& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    params.tournament_size = tournament_size;
+    params.local_search_elites = local_search_elites;
+    params.local_search_budget = local_search_budget;
+    params.surrogate_pool = surrogate_pool;
+
+    // The given architectures through the same evaluation as a generation
+    if (batch_mode) {
+        std::vector<Architecture::Genome::Values> genomes;
+        Batch::Order order;
+        std::pair<unsigned, unsigned> slice;
+        try {
+            if (!evaluate_file.empty()) {
+                std::ifstream file{evaluate_file};
+                if (!file) {
+                    std::cerr << "Cannot open " << evaluate_file << std::endl;
+                    return 1;
+                }
+                genomes = Batch::read(file);
+            }
+            if (!sweep.empty()) {
+                for (const auto& genome : Batch::sweep(sweep)) {
+                    genomes.push_back(genome);
+                }
+            }
+            order = Batch::parse_order(batch_order);
+            slice = Batch::parse_shard(shard);
+        }
+        catch (const std::invalid_argument& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+
+        Philox rng = Random::stream(Random::Domain::BATCH, 0);
+        std::vector<Batch::Entry> entries = Batch::schedule(genomes, order,
+                                                            slice.first,
+                                                            slice.second, rng);
+        Population batch{benchmarks};
+        std::vector<std::uint64_t> jobs;
+        for (const Batch::Entry& entry : entries) {
+            batch.add(entry.genome);
+            jobs.push_back(entry.index);
+        }
+        std::cerr << "Running " << entries.size() << " of " << genomes.size()
+            << " architectures (shard " << shard << ")" << std::endl;
+
+        criteria.wall_budget = wall_budget_hours * 3600;
+        criteria.cpu_budget = cpu_budget_hours * 3600;
+        GeneticAlgorithm evaluator{params, vtr_path, benchmarks, workspace};
+        evaluator.set_termination(std::make_shared<Termination>(criteria));
+        std::shared_ptr<EvaluationArchive> archive;
+        if (!archive_path.empty()) {
+            archive = std::make_shared<EvaluationArchive>(archive_path);
+            if (!archive->ok()) {
+                std::cerr << "Cannot open " << archive_path
+                    << " as an evaluation archive" << std::endl;
+                return 1;
+            }
+            evaluator.set_archive(archive);
+        }
+
+        Batch::write_csv_header(std::cout);
+        evaluator.evaluate(batch, jobs, [&](unsigned i) {
+            Batch::write_csv(std::cout, entries[i].index, batch.to_architecture(i));
+            std::cout.flush();
+        });
+
+        if (archive) {
+            archive->flush();
+            if (!archive->ok()) {
+                std::cerr << "Could not write all evaluations to "
+                    << archive_path << std::endl;
+            }
+        }
+        return 0;
+    }
+
+    (output_csv ? std::cerr : std::cout) << "Initial sampling: "
+        << Sampling::method_name(params.initial_sampling) << std::endl;
+    if (num_islands == 0) {
+        std::cerr << "There must be at least one island" << std::endl;
+        return 1;
+    }
+    // Each island gets its own random streams
+    IslandModel ga{std::vector<GeneticAlgorithm::Params>(num_islands, params),
+                   vtr_path, benchmarks, workspace, migration};
+
+    Architecture::Genome::Values baseline_genome;
+    if (!baseline.empty() || !reference_path.empty()) {
+        Population results;
+        try {
+            if (!baseline.empty()) {
+                baseline_genome = GeneticAlgorithm::parse_baseline(baseline);
+            }
+            if (!reference_path.empty()) {
+                results = WarmStart::load(reference_path, benchmarks);
+            }
+        }
+        catch (const std::invalid_argument& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+
+        // The baseline's results, or the first that did not fail
+        unsigned from = results.size();
+        for (unsigned i = 0; i < results.size() && from == results.size(); i++) {
+            if (results.non_failed(i) && (baseline.empty()
+                || Architecture::Genome::equal(results.genome(i), baseline_genome))) {
+                from = i;
+            }
+        }
+        if (from < results.size()) {
+            ga.set_reference(std::make_shared<Architecture>(results.to_architecture(from)));
+            (output_csv ? std::cerr : std::cout) << "Reference: K="
+                << results.K(from) << ", N=" << results.N(from)
+                << ", W=" << results.W(from) << " from "
+                << reference_path << std::endl;
+        }
+        else if (!baseline.empty()) {
+            ga.set_baseline(baseline_genome);
+            (output_csv ? std::cerr : std::cout) << "Reference: K="
+                << baseline_genome[Architecture::GENE_K]
+                << ", N=" << baseline_genome[Architecture::GENE_N]
+                << ", W=" << baseline_genome[Architecture::GENE_W]
+                << ", run with the first generation" << std::endl;
+        }
+        else {
+            std::cerr << "No architecture in " << reference_path
+                << " has results for every benchmark" << std::endl;
+            return 1;
+        }
+    }
+
+    if (!warm_start.empty()) {
+        Population results;
+        try {
+            results = WarmStart::load(warm_start, benchmarks);
+        }
+        catch (const std::invalid_argument& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+        if (options.count("warm-start-count") == 0) {
+            warm_start_count = num_islands * num_population / 2;
+        }
+        std::vector<unsigned> seeds = WarmStart::best(results, warm_start_count);
+        ga.warm_start(results, seeds);
+        (output_csv ? std::cerr : std::cout) << "Warm start: " << seeds.size()
+            << " of " << results.size() << " architectures in "
+            << warm_start << std::endl;
+    }
+
+    // The clock starts here
+    criteria.wall_budget = wall_budget_hours * 3600;
+    criteria.cpu_budget = cpu_budget_hours * 3600;
+    auto termination = std::make_shared<Termination>(criteria);
+    ga.set_termination(termination);
+
+    std::shared_ptr<EvaluationArchive> archive;
+    if (!archive_path.empty()) {
+        archive = std::make_shared<EvaluationArchive>(archive_path);
+        if (!archive->ok()) {
+            std::cerr << "Cannot open " << archive_path
+                << " as an evaluation archive" << std::endl;
+            return 1;
+        }
+        ga.set_archive(archive);
+    }
 
     // Output header
     if (output_csv) {
         std::cout << "generation," \
             "best_crit,best_area," \
-            "worst_crit,worst_area" << std::endl;
+            "worst_crit,worst_area," \
+            "best_pack_time,best_place_time,best_route_time," \
+            "best_route_iters,best_wirelength," \
+            "best_peak_rss_kb,best_cpu_time," \
+            "mutation_amount,mutation_occurrence," \
+            "surrogate_correlation" << std::endl;
     }
 
 #ifdef _OPENMP
@@ -104,18 +471,45 @@ int main(int argc, char* argv[]) {
     unsigned cnt = 0;
     while (keep_going) {
         ga.run_generation();
+        // Also keeps the best so far
+        Termination::Reason why = termination->update(ga.population());
 
-        if (cnt % interval == 0) {
+        if (cnt % interval == 0 && !ga.population().empty()) {
+            const Architecture best = ga.get_best();
+            // Only changes when it is adapted
+            const Population::Strategy strategy = ga.mutation_strategy();
             if (output_csv) {
+                const Architecture worst = ga.get_worst();
+                // Summed over all benchmarks
+                Architecture::Benchmark::Stats stats = best.total_stats();
                 std::cout << cnt << ","
-                    << ga.get_best().vs_ref_crit_path() << ","
-                    << ga.get_best().vs_ref_area() << ","
-                    << ga.get_worst().vs_ref_crit_path() << ","
-                    << ga.get_worst().vs_ref_area() << std::endl;
+                    << best.vs_ref_crit_path(ga.reference()) << ","
+                    << best.vs_ref_area(ga.reference()) << ","
+                    << worst.vs_ref_crit_path(ga.reference()) << ","
+                    << worst.vs_ref_area(ga.reference()) << ","
+                    << stats.pack_time << ","
+                    << stats.place_time << ","
+                    << stats.route_time << ","
+                    << stats.route_iterations << ","
+                    << stats.wirelength << ","
+                    << stats.peak_rss << ","
+                    << stats.cpu_time << ","
+                    << strategy.mutation_amount << ","
+                    << strategy.mutation_occurrence_rate << ","
+                    << ga.surrogate_correlation() << std::endl;
             }
             else {
                 std::cout << "Results from gen " << cnt << std::endl;
-                std::cout << ga.get_best() << std::endl;
+                std::cout << best << std::endl;
+                if (mutation_adaptation != "none") {
+                    std::cout << "Mutation amount " << strategy.mutation_amount
+                        << ", occurrence rate "
+                        << strategy.mutation_occurrence_rate << std::endl;
+                }
+                if (surrogate_pool > 0) {
+                    std::cout << "Surrogate rank correlation "
+                        << ga.surrogate_correlation() << std::endl;
+                }
             }
         }
 
@@ -123,11 +517,60 @@ int main(int argc, char* argv[]) {
             break;
         }
 
+        if (why != Termination::Reason::NONE) {
+            (output_csv ? std::cerr : std::cout) << "Stopped after generation "
+                << cnt << ": " << Termination::reason_name(why) << std::endl;
+            break;
+        }
+
         cnt++;
     }
 
-    if (output_csv) {
-        std::cerr << ga.get_best() << std::endl;
+    // The last generation may not have it any more
+    if (termination->has_best()) {
+        (output_csv ? std::cerr : std::cout) << "Best architecture found"
+            << std::endl << termination->best() << std::endl;
+    }
+
+    if (params.objective == GeneticAlgorithm::Objective::PARETO) {
+        const ParetoArchive& front = ga.pareto_front();
+        std::ostream& os = output_csv ? std::cerr : std::cout;
+        os << "Pareto front of " << front.size()
+            << " architectures (K, N, W, crit path and area ratios)" << std::endl;
+        for (unsigned i = 0; i < front.size(); i++) {
+            const Architecture& arch = front.front()[i];
+            os << arch.K << "," << arch.N << "," << arch.W << ","
+                << front.points()[i].first << ","
+                << front.points()[i].second << std::endl;
+        }
+    }
+
+    if (prescreen) {
+        (output_csv ? std::cerr : std::cout) << "Skipped "
+            << ga.num_prescreened()
+            << " candidates by pre-screening" << std::endl;
+    }
+
+    if (local_search_elites > 0) {
+        (output_csv ? std::cerr : std::cout) << "Ran "
+            << ga.num_local_evaluations()
+            << " architectures in the local search" << std::endl;
+    }
+
+    if (route_rule.enabled) {
+        (output_csv ? std::cerr : std::cout) << "Stopped "
+            << RouteMonitor::total_abandoned()
+            << " unroutable VPR runs, saving about "
+            << RouteMonitor::total_saved_time()
+            << " seconds of routing" << std::endl;
+    }
+
+    if (archive) {
+        archive->flush();
+        if (!archive->ok()) {
+            std::cerr << "Could not write all evaluations to "
+                << archive_path << std::endl;
+        }
     }
 
     return 0;
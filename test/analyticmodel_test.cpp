@@ -0,0 +1,57 @@
+#define BOOST_TEST_MODULE AnalyticModelTest
+#include <boost/test/unit_test.hpp>
+
+#include "AnalyticModel.h"
+
+#include <cmath>
+
+BOOST_AUTO_TEST_CASE(analyticmodel_routable_test) {
+    unsigned min_w = AnalyticModel::channel_width_estimate(6, 10);
+    BOOST_CHECK_EQUAL(min_w % 2, 0);
+    BOOST_CHECK(AnalyticModel::estimate(6, 10, min_w).routable);
+    BOOST_CHECK(!AnalyticModel::estimate(6, 10, min_w - 2).routable);
+
+    // Larger clusters need wider channels
+    BOOST_CHECK_GT(AnalyticModel::channel_width_estimate(25, 50), min_w);
+    BOOST_CHECK(!AnalyticModel::estimate(25, 50, min_w).routable);
+
+    // Degenerate architectures never route
+    BOOST_CHECK(!AnalyticModel::estimate(1, 10, 100).routable);
+    BOOST_CHECK(!AnalyticModel::estimate(6, 0, 100).routable);
+}
+
+BOOST_AUTO_TEST_CASE(analyticmodel_trend_test) {
+    // Wider channels only cost area
+    auto narrow = AnalyticModel::estimate(6, 10, 50);
+    auto wide = AnalyticModel::estimate(6, 10, 200);
+    BOOST_CHECK_LT(narrow.area, wide.area);
+    BOOST_CHECK_EQUAL(narrow.delay, wide.delay);
+
+    // Fewer levels of logic with larger LUTs
+    BOOST_CHECK_LT(AnalyticModel::estimate(8, 10, 100).delay,
+                   AnalyticModel::estimate(4, 10, 100).delay);
+}
+
+BOOST_AUTO_TEST_CASE(analyticmodel_ratio_estimate_test) {
+    Architecture ref;
+    ref.K = 6;
+    ref.N = 10;
+    ref.W = 100;
+
+    // Compared to itself, the estimate is the slack
+    auto estimate = AnalyticModel::ratio_estimate(ref, ref, 0.5);
+    BOOST_CHECK_CLOSE(estimate.first, 0.5, 1e-6);
+    BOOST_CHECK_CLOSE(estimate.second, 0.5, 1e-6);
+    BOOST_CHECK_CLOSE(AnalyticModel::fitness_estimate(ref, ref, 0.5), 0.5, 1e-6);
+
+    Architecture unroutable{ref};
+    unroutable.W = 2;
+    BOOST_CHECK(std::isinf(AnalyticModel::fitness_estimate(unroutable, ref, 0.5)));
+
+    // The slack also applies to the channel width
+    Architecture narrow{ref};
+    narrow.W = AnalyticModel::channel_width_estimate(6, 10) - 2;
+    BOOST_CHECK(!AnalyticModel::estimate(narrow.K, narrow.N, narrow.W).routable);
+    BOOST_CHECK(std::isfinite(AnalyticModel::fitness_estimate(narrow, ref, 0.5)));
+    BOOST_CHECK(std::isinf(AnalyticModel::fitness_estimate(narrow, ref, 1)));
+}
@@ -3,6 +3,11 @@
 
 #include "Architecture.h"
 
+#include <fcntl.h>
+#include <unistd.h>
+#include <fstream>
+#include <sstream>
+#include <string>
 #include <vector>
 
 BOOST_AUTO_TEST_CASE(architecture_ctor_test) {
@@ -61,3 +66,54 @@ BOOST_AUTO_TEST_CASE(architecture_random_test) {
     }
     BOOST_CHECK_GE(static_cast<float>(cnt) / architectures.size(), 0.9);
 }
+
+BOOST_AUTO_TEST_CASE(architecture_total_stats_test) {
+    Architecture a{std::vector<Architecture::Benchmark>(2)};
+    a.bench[0].stats.route_time = 1.5;
+    a.bench[0].stats.route_iterations = 10;
+    a.bench[0].stats.peak_rss = 2000;
+    a.bench[1].stats.route_time = 2.5;
+    a.bench[1].stats.route_iterations = 5;
+    a.bench[1].stats.peak_rss = 1000;
+
+    Architecture::Benchmark::Stats total = a.total_stats();
+    BOOST_CHECK_EQUAL(total.route_time, 4.0);
+    BOOST_CHECK_EQUAL(total.route_iterations, 15);
+    BOOST_CHECK_EQUAL(total.peak_rss, 2000);
+    BOOST_CHECK_EQUAL(total.pack_time, 0);
+}
+
+BOOST_AUTO_TEST_CASE(architecture_memfd_test) {
+    std::ofstream("architecture_test_template.xml") << "<architecture/>\n";
+    Workspace ws{"/tmp", "architecture_test_template.xml"};
+    BOOST_REQUIRE(ws.ok());
+    BOOST_REQUIRE(ws.stage({}));
+    unlink("architecture_test_template.xml");
+
+    Architecture a{std::vector<Architecture::Benchmark>{}};
+    a.K = 6;
+    a.N = 10;
+    a.W = 84;
+
+    ws.set_memfd(true);
+    std::string path = a.make_arch_file(ws);
+    BOOST_REQUIRE(!path.empty());
+
+    std::stringstream ss;
+    ss << std::ifstream(path).rdbuf();
+    BOOST_CHECK_EQUAL(ss.str().find("<architecture/>"), 0);
+
+    if (path.find("/proc/self/fd/") == 0) {
+        // Sealed, cannot be written anymore
+        int fd = std::stoi(path.substr(14));
+        BOOST_CHECK_EQUAL(write(fd, "x", 1), -1);
+        BOOST_CHECK_NE(fcntl(fd, F_GET_SEALS), -1);
+    }
+
+    // Without memfd it is a regular file in the job directory
+    ws.reject_memfd();
+    BOOST_CHECK(!ws.use_memfd());
+    path = a.make_arch_file(ws);
+    BOOST_CHECK_EQUAL(path.find(ws.root()), 0);
+    BOOST_CHECK_EQUAL(access(path.c_str(), F_OK), 0);
+}
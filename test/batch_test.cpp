@@ -0,0 +1,102 @@
+#define BOOST_TEST_MODULE BatchTest
+#include <boost/test/unit_test.hpp>
+
+#include "Batch.h"
+
+#include <sstream>
+#include <stdexcept>
+#include <unordered_set>
+
+using Values = Architecture::Genome::Values;
+
+BOOST_AUTO_TEST_CASE(batch_read_test) {
+    std::istringstream plain{"# hand-picked\n6,10,80\n\n4 8 100\n6,10,80\n"};
+    std::vector<Values> genomes = Batch::read(plain);
+    BOOST_REQUIRE_EQUAL(genomes.size(), 2);
+    BOOST_CHECK(genomes[0] == (Values{{6, 10, 80}}));
+    BOOST_CHECK(genomes[1] == (Values{{4, 8, 100}}));
+
+    // Columns by name, one architecture for all its benchmarks
+    std::istringstream archive{
+        "generation,K,N,W,benchmark,status\n"
+        "3,6,10,80,a.blif,success\n"
+        "3,6,10,80,b.blif,success\n"
+        "4,5,2,40,a.blif,error\n"};
+    genomes = Batch::read(archive);
+    BOOST_REQUIRE_EQUAL(genomes.size(), 2);
+    BOOST_CHECK(genomes[1] == (Values{{5, 2, 40}}));
+
+    std::istringstream odd{"6,10,81\n"};
+    BOOST_CHECK_THROW(Batch::read(odd), std::invalid_argument);
+    std::istringstream short_line{"6,10\n"};
+    BOOST_CHECK_THROW(Batch::read(short_line), std::invalid_argument);
+    std::istringstream no_columns{"a,b,c\n1,2,3\n"};
+    BOOST_CHECK_THROW(Batch::read(no_columns), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(batch_sweep_test) {
+    std::vector<Values> genomes = Batch::sweep("K=4:6,N=10:20:10,W=80:84");
+    // W steps by 2 by default, and turns fastest
+    BOOST_REQUIRE_EQUAL(genomes.size(), 3 * 2 * 3);
+    BOOST_CHECK(genomes[0] == (Values{{4, 10, 80}}));
+    BOOST_CHECK(genomes[1] == (Values{{4, 10, 82}}));
+    BOOST_CHECK(genomes[3] == (Values{{4, 20, 80}}));
+    BOOST_CHECK(genomes.back() == (Values{{6, 20, 84}}));
+
+    BOOST_CHECK_EQUAL(Batch::sweep("W=100,N=10,K=6").size(), 1);
+    BOOST_CHECK_THROW(Batch::sweep("K=4:6,N=10"), std::invalid_argument);
+    BOOST_CHECK_THROW(Batch::sweep("K=4:6,N=10,W=81"), std::invalid_argument);
+    BOOST_CHECK_THROW(Batch::sweep("K=6:4,N=10,W=80"), std::invalid_argument);
+    BOOST_CHECK_THROW(Batch::sweep("K=4,K=5,N=10,W=80"), std::invalid_argument);
+    BOOST_CHECK_THROW(Batch::sweep("K=4:6:0,N=10,W=80"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(batch_schedule_test) {
+    BOOST_CHECK(Batch::parse_shard("1/3") == std::make_pair(1u, 3u));
+    BOOST_CHECK_THROW(Batch::parse_shard("3/3"), std::invalid_argument);
+    BOOST_CHECK_THROW(Batch::parse_shard("1"), std::invalid_argument);
+    BOOST_CHECK(Batch::parse_order("cost") == Batch::Order::COST);
+    BOOST_CHECK_THROW(Batch::parse_order("random"), std::invalid_argument);
+
+    std::vector<Values> genomes = Batch::sweep("K=4:6,N=10:20:10,W=80:84");
+    Philox rng{7};
+
+    // The shards cover the list once, and keep the indices of the list
+    std::unordered_set<unsigned> seen;
+    for (unsigned shard = 0; shard < 4; shard++) {
+        for (const Batch::Entry& e : Batch::schedule(genomes, Batch::Order::SHUFFLE,
+                                                     shard, 4, rng)) {
+            BOOST_CHECK_EQUAL(e.index % 4, shard);
+            BOOST_CHECK(e.genome == genomes[e.index]);
+            BOOST_CHECK(seen.insert(e.index).second);
+        }
+    }
+    BOOST_CHECK_EQUAL(seen.size(), genomes.size());
+
+    // Widest channels first
+    std::vector<Batch::Entry> entries = Batch::schedule(genomes, Batch::Order::COST,
+                                                        0, 1, rng);
+    BOOST_CHECK(entries.front().genome == (Values{{6, 20, 84}}));
+    BOOST_CHECK(entries.back().genome == (Values{{4, 10, 80}}));
+}
+
+BOOST_AUTO_TEST_CASE(batch_csv_test) {
+    Architecture arch{{Architecture::Benchmark{"a.blif"}, Architecture::Benchmark{"b.blif"}}};
+    arch.set_genome(Values{{6, 10, 80}});
+    arch.bench[1].set_failed(Architecture::Benchmark::Status::UNROUTABLE);
+
+    std::ostringstream os;
+    Batch::write_csv(os, 12, arch);
+    std::istringstream lines{os.str()};
+    std::string line;
+    std::getline(lines, line);
+    BOOST_CHECK_EQUAL(line.substr(0, 24), "12,6,10,80,a.blif,not_ru");
+    std::getline(lines, line);
+    BOOST_CHECK_EQUAL(line.substr(0, 29), "12,6,10,80,b.blif,unroutable,");
+
+    // Can be read back
+    std::ostringstream header;
+    Batch::write_csv_header(header);
+    std::istringstream back{header.str() + os.str()};
+    BOOST_CHECK_EQUAL(Batch::read(back).size(), 1);
+}
@@ -0,0 +1,83 @@
+#define BOOST_TEST_MODULE BayesianOptimizerTest
+#include <boost/test/unit_test.hpp>
+
+#include "BayesianOptimizer.h"
+
+#include <cmath>
+#include <unordered_set>
+
+namespace {
+
+using Values = Architecture::Genome::Values;
+
+/* Smooth in every gene, best at K = 6, N = 10, W = 80 */
+double bowl(const Values& genome) {
+    const double k = genome[0] - 6.0;
+    const double n = genome[1] - 10.0;
+    const double w = genome[2] - 80.0;
+    return 1 + k * k / 100 + n * n / 400 + w * w / 10000;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(bayesianoptimizer_expected_improvement_test) {
+    // Nothing to gain from a certain prediction above the best
+    BOOST_CHECK_EQUAL(BayesianOptimizer::expected_improvement(2, 0, 1), 0);
+    BOOST_CHECK_CLOSE(BayesianOptimizer::expected_improvement(0.5, 0, 1), 0.5, 1e-9);
+
+    // More uncertainty, more to gain
+    BOOST_CHECK_GT(BayesianOptimizer::expected_improvement(1, 0.2, 1),
+                   BayesianOptimizer::expected_improvement(1, 0.1, 1));
+    BOOST_CHECK_GT(BayesianOptimizer::expected_improvement(0.9, 0.1, 1),
+                   BayesianOptimizer::expected_improvement(1.1, 0.1, 1));
+}
+
+BOOST_AUTO_TEST_CASE(bayesianoptimizer_predict_test) {
+    BayesianOptimizer optimizer;
+    for (unsigned k = 2; k <= 24; k += 6) {
+        for (unsigned n = 2; n <= 50; n += 12) {
+            for (unsigned w = 20; w <= 240; w += 60) {
+                Values genome{{k, n, w}};
+                optimizer.add(genome, bowl(genome));
+            }
+        }
+    }
+    BOOST_CHECK_EQUAL(optimizer.size(), 80);
+
+    // Close to the ones added, and surer there than far from them
+    BayesianOptimizer::Prediction known = optimizer.predict(Values{{8, 14, 80}});
+    BOOST_CHECK_CLOSE(known.mean, bowl(Values{{8, 14, 80}}), 5);
+    BayesianOptimizer::Prediction probe = optimizer.predict(Values{{6, 10, 100}});
+    BOOST_CHECK_CLOSE(probe.mean, bowl(Values{{6, 10, 100}}), 10);
+    BOOST_CHECK_LT(known.deviation, probe.deviation);
+}
+
+BOOST_AUTO_TEST_CASE(bayesianoptimizer_propose_test) {
+    Philox rng{5};
+    BayesianOptimizer optimizer;
+
+    // Random before there is anything to fit to
+    std::vector<Values> first = optimizer.propose(4, rng);
+    BOOST_CHECK_EQUAL(first.size(), 4);
+
+    std::unordered_set<std::uint64_t> known;
+    for (const Values& genome : first) {
+        optimizer.add(genome, bowl(genome));
+        known.insert(Architecture::Genome::key(genome));
+    }
+    optimizer.exclude(Values{{6, 10, 80}});
+    known.insert(Architecture::Genome::key(Values{{6, 10, 80}}));
+
+    // A batch of distinct, valid architectures not run or excluded
+    for (unsigned round = 0; round < 3; round++) {
+        std::vector<Values> batch = optimizer.propose(6, rng);
+        BOOST_CHECK_EQUAL(batch.size(), 6);
+        for (const Values& genome : batch) {
+            BOOST_CHECK(Architecture::Genome::valid(genome));
+            BOOST_CHECK(known.insert(Architecture::Genome::key(genome)).second);
+        }
+        for (const Values& genome : batch) {
+            optimizer.add(genome, bowl(genome));
+        }
+    }
+}
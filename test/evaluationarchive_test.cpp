@@ -0,0 +1,202 @@
+#define BOOST_TEST_MODULE EvaluationArchiveTest
+#include <boost/test/unit_test.hpp>
+
+#include "ArchiveReader.h"
+#include "EvaluationArchive.h"
+
+#include <unistd.h>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+std::string temp_path() {
+    char buf[] = "/tmp/evaluationarchive_testXXXXXX";
+    int fd = mkstemp(buf);
+    close(fd);
+    unlink(buf);
+    return std::string{buf};
+}
+
+Architecture make_arch(unsigned K, unsigned N, unsigned W) {
+    std::vector<Architecture::Benchmark> bench{
+        Architecture::Benchmark{"/benchmarks/ch_intrinsics.blif"},
+        Architecture::Benchmark{"/benchmarks/diffeq1.blif"}
+    };
+    Architecture a{bench};
+    a.K = K;
+    a.N = N;
+    a.W = W;
+    for (unsigned i = 0; i < a.bench.size(); i++) {
+        a.bench[i].area = 1000 * (i + 1);
+        a.bench[i].crit_path = 2.5 * (i + 1);
+        a.bench[i].is_populated = true;
+        a.bench[i].status = Architecture::Benchmark::Status::SUCCESS;
+        a.bench[i].stats.route_iterations = 10 + i;
+        a.bench[i].stats.peak_rss = 4096;
+    }
+    return a;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(evaluationarchive_roundtrip_test) {
+    std::string path = temp_path();
+    {
+        EvaluationArchive archive{path};
+        BOOST_REQUIRE(archive.ok());
+        archive.append(0, make_arch(6, 10, 84));
+        Architecture failed = make_arch(4, 8, 40);
+        failed.bench[1].set_failed(Architecture::Benchmark::Status::UNROUTABLE);
+        archive.append(1, failed);
+        archive.flush();
+        // 2 names and 4 evaluations
+        BOOST_CHECK_EQUAL(archive.written(), 6);
+    }
+
+    ArchiveReader reader{path};
+    BOOST_REQUIRE(reader.ok());
+    BOOST_CHECK_EQUAL(reader.size(), 6);
+
+    std::vector<ArchiveReader::Evaluation> all;
+    std::vector<std::string> names;
+    ArchiveReader::Filter filter;
+    BOOST_CHECK_EQUAL(reader.for_each(filter, [&](const ArchiveReader::Evaluation& e,
+                                                  const std::string& name) {
+                                      all.push_back(e);
+                                      names.push_back(name);
+                                      }), 4);
+    BOOST_REQUIRE_EQUAL(all.size(), 4);
+    BOOST_CHECK_EQUAL(all[0].generation, 0);
+    BOOST_CHECK_EQUAL(all[0].K, 6);
+    BOOST_CHECK_EQUAL(all[0].N, 10);
+    BOOST_CHECK_EQUAL(all[0].W, 84);
+    BOOST_CHECK_EQUAL(all[0].area, 1000);
+    BOOST_CHECK_EQUAL(all[1].crit_path, 5);
+    BOOST_CHECK_EQUAL(all[1].route_iterations, 11);
+    BOOST_CHECK_EQUAL(all[1].peak_rss, 4096);
+    BOOST_CHECK_EQUAL(names[0], "ch_intrinsics.blif");
+    BOOST_CHECK_EQUAL(names[3], "diffeq1.blif");
+    BOOST_CHECK_EQUAL(ArchiveReader::status_name(all[3].status), "unroutable");
+
+    // Filters
+    filter.min_generation = 1;
+    BOOST_CHECK_EQUAL(reader.for_each(filter, [](const ArchiveReader::Evaluation&,
+                                                 const std::string&) {}), 2);
+    filter.success_only = true;
+    BOOST_CHECK_EQUAL(reader.for_each(filter, [](const ArchiveReader::Evaluation&,
+                                                 const std::string&) {}), 1);
+    filter = ArchiveReader::Filter{};
+    filter.benchmark = "diffeq1.blif";
+    filter.W = 84;
+    BOOST_CHECK_EQUAL(reader.for_each(filter, [](const ArchiveReader::Evaluation&,
+                                                 const std::string&) {}), 1);
+
+    // CSV
+    std::ostringstream os;
+    ArchiveReader::write_csv(os, all[0], names[0]);
+    BOOST_CHECK_EQUAL(os.str().find("0,6,10,84,ch_intrinsics.blif,success,1000,2.5,"), 0);
+
+    unlink(path.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(evaluationarchive_append_test) {
+    std::string path = temp_path();
+    {
+        EvaluationArchive archive{path};
+        archive.append(0, make_arch(6, 10, 84));
+    }
+    {
+        // A second run appends and introduces its names again
+        EvaluationArchive archive{path};
+        BOOST_REQUIRE(archive.ok());
+        archive.append(0, make_arch(5, 4, 60));
+    }
+
+    ArchiveReader reader{path};
+    BOOST_REQUIRE(reader.ok());
+    BOOST_CHECK_EQUAL(reader.size(), 8);
+    ArchiveReader::Filter filter;
+    filter.benchmark = "ch_intrinsics.blif";
+    BOOST_CHECK_EQUAL(reader.for_each(filter, [](const ArchiveReader::Evaluation&,
+                                                 const std::string&) {}), 2);
+
+    unlink(path.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(evaluationarchive_shared_test) {
+    std::string path = temp_path();
+    {
+        // Two writers at once, which give their benchmarks opposite ids
+        EvaluationArchive first{path};
+        EvaluationArchive second{path};
+        Architecture reversed = make_arch(5, 4, 60);
+        std::swap(reversed.bench[0], reversed.bench[1]);
+
+        first.append(0, make_arch(6, 10, 84));
+        first.flush();
+        second.append(0, reversed);
+        second.flush();
+        first.append(1, make_arch(6, 10, 84));
+        first.flush();
+        BOOST_CHECK(first.ok());
+        BOOST_CHECK(second.ok());
+    }
+
+    ArchiveReader reader{path};
+    BOOST_REQUIRE(reader.ok());
+    ArchiveReader::Filter filter;
+    filter.benchmark = "ch_intrinsics.blif";
+    std::vector<double> areas;
+    BOOST_CHECK_EQUAL(reader.for_each(filter, [&](const ArchiveReader::Evaluation& e,
+                                                  const std::string&) {
+                                      areas.push_back(e.area);
+                                      }), 3);
+    // make_arch gives ch_intrinsics an area of 1000, even once swapped
+    BOOST_CHECK((areas == std::vector<double>{1000, 1000, 1000}));
+
+    unlink(path.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(evaluationarchive_create_shared_test) {
+    std::string path = temp_path();
+    {
+        // Both open the new file before either writes
+        EvaluationArchive first{path};
+        EvaluationArchive second{path};
+        BOOST_CHECK(first.ok());
+        BOOST_CHECK(second.ok());
+    }
+
+    // One header and nothing else
+    std::ifstream is(path, std::ios::binary | std::ios::ate);
+    BOOST_CHECK_EQUAL(is.tellg(), sizeof(EvaluationArchive::Header));
+    ArchiveReader reader{path};
+    BOOST_CHECK(reader.ok());
+    BOOST_CHECK_EQUAL(reader.size(), 0);
+
+    unlink(path.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(evaluationarchive_foreign_file_test) {
+    std::string path = temp_path();
+    std::ofstream(path) << "generation,best_crit,best_area\n";
+
+    EvaluationArchive archive{path};
+    BOOST_CHECK(!archive.ok());
+    ArchiveReader reader{path};
+    BOOST_CHECK(!reader.ok());
+    BOOST_CHECK_EQUAL(reader.size(), 0);
+
+    // Left alone
+    std::ifstream is(path);
+    std::string line;
+    std::getline(is, line);
+    BOOST_CHECK_EQUAL(line, "generation,best_crit,best_area");
+
+    unlink(path.c_str());
+}
@@ -23,3 +23,173 @@ BOOST_AUTO_TEST_CASE(ga_change_generation_test) {
     bool different = before != after;
     BOOST_CHECK(different);
 }
+
+BOOST_AUTO_TEST_CASE(ga_adaptation_test) {
+    using Adaptation = GeneticAlgorithm::Adaptation;
+    BOOST_CHECK(GeneticAlgorithm::parse_adaptation("one-fifth") == Adaptation::ONE_FIFTH);
+    BOOST_CHECK(GeneticAlgorithm::parse_adaptation("log-normal") == Adaptation::LOG_NORMAL);
+    BOOST_CHECK_THROW(GeneticAlgorithm::parse_adaptation("cma"), std::invalid_argument);
+
+    GeneticAlgorithm::Params params{4, 0, 2, 0.1f, 0.2f, 0.0};
+    BOOST_CHECK(params.adaptation == Adaptation::NONE);
+    params.adaptation = Adaptation::LOG_NORMAL;
+
+    // Random architectures start from the parameters
+    GeneticAlgorithm ga{params, ""};
+    ga.change_generation();
+    BOOST_CHECK_EQUAL(ga.population().size(), 4);
+    BOOST_CHECK_CLOSE(ga.mutation_strategy().mutation_amount, 0.2f, 1e-3);
+    BOOST_CHECK_CLOSE(ga.mutation_strategy().mutation_occurrence_rate, 0.1f, 1e-3);
+}
+
+BOOST_AUTO_TEST_CASE(ga_adaptation_step_test) {
+    using Strategy = Population::Strategy;
+    const Strategy start{0.2f, 0.5f};
+
+    // One success undoes four failures
+    Strategy grown = GeneticAlgorithm::one_fifth_step(start, true);
+    BOOST_CHECK_GT(grown.mutation_amount, start.mutation_amount);
+    BOOST_CHECK_GT(grown.mutation_occurrence_rate, start.mutation_occurrence_rate);
+    Strategy shrunk = GeneticAlgorithm::one_fifth_step(start, false);
+    BOOST_CHECK_LT(shrunk.mutation_amount, start.mutation_amount);
+    BOOST_CHECK_LT(shrunk.mutation_occurrence_rate, start.mutation_occurrence_rate);
+    Strategy balanced = grown;
+    for (unsigned i = 0; i < 4; i++) {
+        balanced = GeneticAlgorithm::one_fifth_step(balanced, false);
+    }
+    BOOST_CHECK_CLOSE(balanced.mutation_amount, start.mutation_amount, 1e-3);
+
+    // Bounded, with the rate below 1
+    Strategy high = start, low = start;
+    for (unsigned i = 0; i < 100; i++) {
+        high = GeneticAlgorithm::one_fifth_step(high, true);
+        low = GeneticAlgorithm::one_fifth_step(low, false);
+    }
+    BOOST_CHECK_LE(high.mutation_amount, 1);
+    BOOST_CHECK_LT(high.mutation_occurrence_rate, 1);
+    BOOST_CHECK_GT(low.mutation_amount, 0);
+    BOOST_CHECK_GT(low.mutation_occurrence_rate, 0);
+
+    // The log-normal steps stay in bounds and do not get stuck at the top
+    Philox rng{7};
+    std::vector<float> rates;
+    for (unsigned i = 0; i < 100; i++) {
+        Strategy next = GeneticAlgorithm::log_normal_step(high, rng);
+        BOOST_CHECK_GT(next.mutation_amount, 0);
+        BOOST_CHECK_LE(next.mutation_amount, 1);
+        BOOST_CHECK_GT(next.mutation_occurrence_rate, 0);
+        BOOST_CHECK_LT(next.mutation_occurrence_rate, 1);
+        rates.push_back(next.mutation_occurrence_rate);
+    }
+    BOOST_CHECK_LT(*std::min_element(rates.begin(), rates.end()),
+                   high.mutation_occurrence_rate);
+}
+
+BOOST_AUTO_TEST_CASE(ga_initial_sampling_test) {
+    GeneticAlgorithm::Params params{16, 0, 2, 0.1f, 0.2f, 0.0};
+    BOOST_CHECK(params.initial_sampling == Sampling::Method::RANDOM);
+    params.initial_sampling = Sampling::Method::SOBOL;
+
+    // The design only depends on the seed
+    GeneticAlgorithm ga1{params, ""};
+    GeneticAlgorithm ga2{params, ""};
+    BOOST_CHECK(ga1.population() == ga2.population());
+    BOOST_REQUIRE_EQUAL(ga1.population().size(), 16);
+    for (unsigned i = 0; i < ga1.population().size(); i++) {
+        BOOST_CHECK(Architecture::Genome::valid(ga1.population().genome(i)));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ga_objective_test) {
+    using Objective = GeneticAlgorithm::Objective;
+    BOOST_CHECK(GeneticAlgorithm::parse_objective("weighted") == Objective::WEIGHTED);
+    BOOST_CHECK(GeneticAlgorithm::parse_objective("pareto") == Objective::PARETO);
+    BOOST_CHECK_THROW(GeneticAlgorithm::parse_objective("area"), std::invalid_argument);
+
+    GeneticAlgorithm::Params params;
+    BOOST_CHECK(params.objective == Objective::WEIGHTED);
+    params.objective = Objective::PARETO;
+    GeneticAlgorithm ga{params, ""};
+    BOOST_CHECK_EQUAL(ga.pareto_front().size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ga_engine_test) {
+    using Engine = GeneticAlgorithm::Engine;
+    BOOST_CHECK(GeneticAlgorithm::parse_engine("genetic") == Engine::GENETIC);
+    BOOST_CHECK(GeneticAlgorithm::parse_engine("bayesian") == Engine::BAYESIAN);
+    BOOST_CHECK_THROW(GeneticAlgorithm::parse_engine("tpe"), std::invalid_argument);
+
+    GeneticAlgorithm::Params params;
+    BOOST_CHECK(params.engine == Engine::GENETIC);
+}
+
+BOOST_AUTO_TEST_CASE(ga_warm_start_test) {
+    std::vector<Architecture::Benchmark> benchmarks{Architecture::Benchmark{"a.blif"}};
+    Population results{benchmarks};
+    for (unsigned W : {60, 80, 100}) {
+        unsigned i = results.add(6, 10, W);
+        results.result(i, 0).area = 1000;
+        results.result(i, 0).crit_path = 4;
+        results.result(i, 0).is_populated = true;
+    }
+
+    GeneticAlgorithm::Params params{6, 1, 2, 0.1f, 0.1f, 0.1f};
+    params.initial_sampling = Sampling::Method::LATIN_HYPERCUBE;
+    GeneticAlgorithm ga{params, "", benchmarks};
+    ga.warm_start(results, {2, 0});
+
+    // Known ones first, not to be run again
+    const Population& population = ga.population();
+    BOOST_REQUIRE_EQUAL(population.size(), 6);
+    BOOST_CHECK_EQUAL(population.W(0), 100);
+    BOOST_CHECK_EQUAL(population.W(1), 60);
+    BOOST_CHECK(population.already_run(0));
+    BOOST_CHECK(population.already_run(1));
+    for (unsigned i = 2; i < population.size(); i++) {
+        BOOST_CHECK(!population.already_run(i));
+        BOOST_CHECK(Architecture::Genome::valid(population.genome(i)));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ga_baseline_test) {
+    using Values = Architecture::Genome::Values;
+    BOOST_CHECK((GeneticAlgorithm::parse_baseline("k6_N10") == Values{{6, 10, 100}}));
+    BOOST_CHECK((GeneticAlgorithm::parse_baseline("k4_N8_W60") == Values{{4, 8, 60}}));
+    BOOST_CHECK((GeneticAlgorithm::parse_baseline("6,10,80") == Values{{6, 10, 80}}));
+    BOOST_CHECK_THROW(GeneticAlgorithm::parse_baseline("k6"), std::invalid_argument);
+    BOOST_CHECK_THROW(GeneticAlgorithm::parse_baseline("k6_N10_W80x"), std::invalid_argument);
+    BOOST_CHECK_THROW(GeneticAlgorithm::parse_baseline("k30_N10"), std::invalid_argument);
+
+    std::vector<Architecture::Benchmark> benchmarks{Architecture::Benchmark{"a.blif"}};
+    GeneticAlgorithm ga{GeneticAlgorithm::Params{4, 1, 2, 0.1f, 0.1f, 0.1f}, "", benchmarks};
+    ga.set_baseline(Values{{6, 10, 100}});
+
+    // Run with the first generation, on top of it
+    std::vector<unsigned> fresh = ga.begin_evaluation();
+    const Population& population = ga.population();
+    BOOST_REQUIRE_EQUAL(population.size(), 5);
+    BOOST_CHECK((population.genome(4) == Values{{6, 10, 100}}));
+    BOOST_CHECK_EQUAL(fresh.size(), 5);
+    BOOST_CHECK(ga.reference().bench.empty());
+}
+
+BOOST_AUTO_TEST_CASE(ga_reference_test) {
+    std::vector<Architecture::Benchmark> benchmarks{Architecture::Benchmark{"a.blif"}};
+    GeneticAlgorithm::Params params{4, 1, 2, 0.1f, 0.1f, 0.1f};
+    GeneticAlgorithm ga1{params, "", benchmarks};
+    GeneticAlgorithm ga2{params, "", benchmarks};
+
+    // Each instance has its own
+    auto reference = std::make_shared<Architecture>(benchmarks);
+    reference->bench[0].area = 1000;
+    reference->bench[0].crit_path = 4;
+    reference->bench[0].is_populated = true;
+    ga1.set_reference(reference);
+    BOOST_CHECK_EQUAL(ga1.reference().bench[0].area, 1000);
+    BOOST_CHECK(ga2.reference().bench.empty());
+    BOOST_CHECK(ga1.population().reference() == reference);
+
+    // Copies share it
+    GeneticAlgorithm copy{ga1};
+    BOOST_CHECK(&copy.reference() == &ga1.reference());
+}
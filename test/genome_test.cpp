@@ -0,0 +1,108 @@
+#define BOOST_TEST_MODULE GenomeTest
+#include <boost/test/unit_test.hpp>
+
+#include "Genome.h"
+
+#include <set>
+
+namespace {
+
+using Even = Gene<2, 250, 2>;
+using Test = GenomeDescriptor<Gene<2, 25>, Gene<1, 50>, Even>;
+
+}
+
+BOOST_AUTO_TEST_CASE(gene_repair_test) {
+    static_assert(Even::repair(7) == 8, "rounds up to the grid");
+    static_assert(Gene<1, 250, 2>::max == 249, "max is on the grid");
+
+    BOOST_CHECK_EQUAL(Even::repair(-5), 2);
+    BOOST_CHECK_EQUAL(Even::repair(0), 2);
+    BOOST_CHECK_EQUAL(Even::repair(3), 4);
+    BOOST_CHECK_EQUAL(Even::repair(80), 80);
+    BOOST_CHECK_EQUAL(Even::repair(249), 250);
+    BOOST_CHECK_EQUAL(Even::repair(1000), 250);
+    BOOST_CHECK_EQUAL(Even::count, 125);
+
+    BOOST_CHECK(Even::valid(2));
+    BOOST_CHECK(!Even::valid(3));
+    BOOST_CHECK(!Even::valid(252));
+}
+
+BOOST_AUTO_TEST_CASE(genome_random_test) {
+    Philox rng{3};
+    std::set<unsigned> widths;
+    for (unsigned i = 0; i < 2000; i++) {
+        Test::Values values = Test::random(rng);
+        BOOST_REQUIRE(Test::valid(values));
+        widths.insert(values[2]);
+    }
+    // Every valid width shows up
+    BOOST_CHECK_EQUAL(widths.size(), Even::count);
+    BOOST_CHECK_EQUAL(*widths.begin(), 2);
+    BOOST_CHECK_EQUAL(*widths.rbegin(), 250);
+}
+
+BOOST_AUTO_TEST_CASE(genome_operators_test) {
+    Philox rng{3};
+    Test::Values a{{6, 10, 80}};
+    Test::Values b{{25, 50, 250}};
+
+    Test::Values mutant = a;
+    Test::mutate(mutant, 0, rng);
+    BOOST_CHECK(Test::equal(mutant, a));
+    for (unsigned i = 0; i < 1000; i++) {
+        Test::mutate(mutant, 0.5f, rng);
+        BOOST_REQUIRE(Test::valid(mutant));
+    }
+
+    // XOR is out of range for K and W, the average is not on the grid for W
+    auto children = Test::crossover(a, b, rng);
+    BOOST_CHECK(Test::valid(children.first));
+    BOOST_CHECK(Test::valid(children.second));
+    BOOST_CHECK_EQUAL(children.first[0], 25);
+    BOOST_CHECK_EQUAL(children.second[0], 15);
+    BOOST_CHECK_EQUAL(children.second[2], 166);
+
+    Test::Values broken{{0, 51, 81}};
+    Test::repair(broken);
+    BOOST_CHECK(Test::equal(broken, Test::Values{{2, 50, 82}}));
+}
+
+BOOST_AUTO_TEST_CASE(genome_key_test) {
+    BOOST_CHECK_EQUAL(Test::KEY_BITS, 21);
+    BOOST_CHECK_EQUAL(Test::key(Test::Values{{6, 10, 80}}),
+                      (6ULL << 42) | (10ULL << 21) | 80);
+    BOOST_CHECK_NE(Test::key(Test::Values{{6, 10, 80}}),
+                   Test::key(Test::Values{{6, 80, 10}}));
+}
+
+BOOST_AUTO_TEST_CASE(genome_neighbours_test) {
+    auto inside = Test::neighbours(Test::Values{{6, 10, 80}});
+    BOOST_REQUIRE_EQUAL(inside.size(), 6);
+    BOOST_CHECK(Test::equal(inside[0], Test::Values{{5, 10, 80}}));
+    BOOST_CHECK(Test::equal(inside[1], Test::Values{{7, 10, 80}}));
+    BOOST_CHECK(Test::equal(inside[2], Test::Values{{6, 9, 80}}));
+    BOOST_CHECK(Test::equal(inside[3], Test::Values{{6, 11, 80}}));
+    BOOST_CHECK(Test::equal(inside[4], Test::Values{{6, 10, 78}}));
+    BOOST_CHECK(Test::equal(inside[5], Test::Values{{6, 10, 82}}));
+
+    // Nothing outside the ranges
+    auto corner = Test::neighbours(Test::Values{{2, 50, 2}});
+    BOOST_REQUIRE_EQUAL(corner.size(), 3);
+    for (const auto& neighbour : corner) {
+        BOOST_CHECK(Test::valid(neighbour));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(genome_unit_test) {
+    for (const Test::Values& values : {Test::Values{{2, 1, 2}},
+                                       Test::Values{{6, 10, 80}},
+                                       Test::Values{{25, 50, 250}}}) {
+        std::vector<double> point = Test::to_unit(values);
+        for (double u : point) {
+            BOOST_CHECK(u > 0 && u < 1);
+        }
+        BOOST_CHECK(Test::equal(Test::from_unit(point), values));
+    }
+}
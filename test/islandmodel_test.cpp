@@ -0,0 +1,75 @@
+#define BOOST_TEST_MODULE IslandModelTest
+#include <boost/test/unit_test.hpp>
+
+#include "IslandModel.h"
+
+#include <memory>
+#include <stdexcept>
+
+namespace {
+
+using Params = GeneticAlgorithm::Params;
+
+/* The reference of one benchmark, at area 100 and critical path 1 */
+std::shared_ptr<Architecture> make_reference() {
+    auto reference = std::make_shared<Architecture>(
+        std::vector<Architecture::Benchmark>(1));
+    reference->bench[0].area = 100;
+    reference->bench[0].crit_path = 1;
+    reference->bench[0].is_populated = true;
+    return reference;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(island_topology_test) {
+    using Topology = IslandModel::Topology;
+    BOOST_CHECK(IslandModel::parse_topology("ring") == Topology::RING);
+    BOOST_CHECK(IslandModel::parse_topology("full") == Topology::FULL);
+    BOOST_CHECK(IslandModel::parse_topology("random") == Topology::RANDOM);
+    BOOST_CHECK_THROW(IslandModel::parse_topology("star"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(island_ctor_test) {
+    BOOST_CHECK_THROW(IslandModel({}, ""), std::invalid_argument);
+
+    Params params{8, 1, 4, 0.1f, 0.2f, 0.3f};
+    IslandModel model{std::vector<Params>(3, params), ""};
+    BOOST_REQUIRE_EQUAL(model.islands().size(), 3);
+    // Same parameters, different random streams
+    BOOST_CHECK_EQUAL(model.islands()[2].parameters().island, 2);
+    BOOST_CHECK(model.islands()[0].population() != model.islands()[1].population());
+    BOOST_CHECK(model.islands()[1].population() != model.islands()[2].population());
+    BOOST_CHECK_EQUAL(model.num_migrations(), 0);
+
+    // One island is the genetic algorithm itself
+    IslandModel single{std::vector<Params>(1, params), ""};
+    GeneticAlgorithm ga{params, ""};
+    BOOST_CHECK(single.population() == ga.population());
+}
+
+BOOST_AUTO_TEST_CASE(island_immigrate_test) {
+    const std::vector<Architecture::Benchmark> benchmarks(1);
+    Population from{benchmarks};
+    from.add(7, 11, 90);
+    Population::Result& r = from.result(0, 0);
+    r.area = 50;
+    r.crit_path = 0.5;
+    r.is_populated = true;
+    r.status = Architecture::Benchmark::Status::SUCCESS;
+
+    GeneticAlgorithm ga{Params{4, 0, 2, 0.0, 0.0, 0.0}, "", benchmarks};
+    ga.set_reference(make_reference());
+    ga.immigrate(from, 0);
+    ga.change_generation();
+
+    // Arrives with its results, in place of a random one
+    const Population& population = ga.population();
+    BOOST_REQUIRE_EQUAL(population.size(), 4);
+    BOOST_CHECK_EQUAL(population.K(0), 7);
+    BOOST_CHECK(population.already_run(0));
+    BOOST_CHECK_CLOSE(population.fitness(0), 0.5, 1e-9);
+    BOOST_CHECK(!population.already_run(1));
+
+    BOOST_CHECK((ga.best(1) == std::vector<unsigned>{0}));
+}
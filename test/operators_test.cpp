@@ -0,0 +1,79 @@
+#define BOOST_TEST_MODULE OperatorsTest
+#include <boost/test/unit_test.hpp>
+
+#include "Operators.h"
+
+#include <stdexcept>
+
+namespace {
+
+const Operators::Crossover crossovers[] = {
+    Operators::Crossover::BLEND,
+    Operators::Crossover::SBX
+};
+
+const Operators::Mutation mutations[] = {
+    Operators::Mutation::POLYNOMIAL,
+    Operators::Mutation::DISCRETE_GAUSSIAN
+};
+
+/* The even channel widths */
+const unsigned MIN = 2, STEP = 2, COUNT = 125;
+
+bool on_grid(long value) {
+    return value >= MIN && value <= MIN + (COUNT - 1) * STEP
+        && (value - MIN) % STEP == 0;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(operators_parse_test) {
+    BOOST_CHECK(Operators::parse_crossover("sbx") == Operators::Crossover::SBX);
+    BOOST_CHECK(Operators::parse_mutation("discrete-gaussian")
+                == Operators::Mutation::DISCRETE_GAUSSIAN);
+    BOOST_CHECK_THROW(Operators::parse_crossover("uniform"), std::invalid_argument);
+    BOOST_CHECK_THROW(Operators::parse_mutation(""), std::invalid_argument);
+
+    Operators operators;
+    BOOST_CHECK(operators.crossover() == Operators::Crossover::XOR);
+    BOOST_CHECK(operators.mutation() == Operators::Mutation::GAUSSIAN);
+}
+
+BOOST_AUTO_TEST_CASE(operators_cross_test) {
+    Philox rng{11};
+    for (Operators::Crossover crossover : crossovers) {
+        Operators operators{crossover, Operators::Mutation::GAUSSIAN};
+        for (unsigned i = 0; i < 2000; i++) {
+            auto children = operators.cross(4, 248, MIN, STEP, COUNT, rng);
+            BOOST_REQUIRE(on_grid(children.first));
+            BOOST_REQUIRE(on_grid(children.second));
+        }
+
+        // Nothing to cross between the same parents for SBX, and no room
+        // around them for BLEND
+        auto children = operators.cross(80, 80, MIN, STEP, COUNT, rng);
+        BOOST_CHECK_EQUAL(children.first, 80);
+        BOOST_CHECK_EQUAL(children.second, 80);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(operators_mutate_test) {
+    Philox rng{11};
+    for (Operators::Mutation mutation : mutations) {
+        Operators operators{Operators::Crossover::XOR, mutation};
+        BOOST_CHECK_EQUAL(operators.mutate(80, 0, MIN, STEP, COUNT, rng), 80);
+
+        for (unsigned value : {2u, 4u, 80u, 250u}) {
+            for (unsigned i = 0; i < 1000; i++) {
+                long mutant = operators.mutate(value, 0.05f, MIN, STEP, COUNT, rng);
+                BOOST_REQUIRE(on_grid(mutant));
+                // Always moves, even at the bounds
+                BOOST_REQUIRE_NE(mutant, value);
+            }
+        }
+    }
+
+    // A gene with a single value stays
+    Operators operators{Operators::Crossover::SBX, Operators::Mutation::POLYNOMIAL};
+    BOOST_CHECK_EQUAL(operators.mutate(3, 0.5f, 3, 1, 1, rng), 3);
+}
@@ -0,0 +1,95 @@
+#define BOOST_TEST_MODULE ParetoArchiveTest
+#include <boost/test/unit_test.hpp>
+
+#include "ParetoArchive.h"
+
+#include <cmath>
+#include <memory>
+
+namespace {
+
+using Objectives = ParetoArchive::Objectives;
+
+/* One benchmark, with the reference at area 100 and critical path 1 */
+Population make_population(const std::vector<Objectives>& points) {
+    std::vector<Architecture::Benchmark> benchmarks(1);
+    auto reference = std::make_shared<Architecture>(benchmarks);
+    reference->bench[0].area = 100;
+    reference->bench[0].crit_path = 1;
+    reference->bench[0].is_populated = true;
+
+    Population population{benchmarks};
+    population.set_reference(reference);
+    for (unsigned i = 0; i < points.size(); i++) {
+        population.add(2 + i, 10, 80);
+        Population::Result& r = population.result(i, 0);
+        r.crit_path = points[i].first;
+        r.area = points[i].second * 100;
+        r.is_populated = true;
+        r.status = Architecture::Benchmark::Status::SUCCESS;
+    }
+    return population;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(pareto_dominates_test) {
+    BOOST_CHECK(ParetoArchive::dominates({1, 1}, {1, 2}));
+    BOOST_CHECK(ParetoArchive::dominates({1, 1}, {2, 2}));
+    BOOST_CHECK(!ParetoArchive::dominates({1, 1}, {1, 1}));
+    BOOST_CHECK(!ParetoArchive::dominates({1, 2}, {2, 1}));
+}
+
+BOOST_AUTO_TEST_CASE(pareto_ranks_test) {
+    // Two fronts: (1, 3) (2, 2) (3, 1), then (2, 3) (3, 2); (4, 4) last
+    std::vector<Objectives> points{{2, 3}, {1, 3}, {4, 4}, {2, 2}, {3, 2}, {3, 1}};
+    auto ranks = ParetoArchive::front_ranks(points);
+    BOOST_CHECK((ranks == std::vector<unsigned>{1, 0, 2, 0, 1, 0}));
+
+    auto distances = ParetoArchive::crowding_distances(points, ranks);
+    // Ends of each front, and the only point of the last one
+    BOOST_CHECK(std::isinf(distances[1]));
+    BOOST_CHECK(std::isinf(distances[5]));
+    BOOST_CHECK(std::isinf(distances[0]));
+    BOOST_CHECK(std::isinf(distances[4]));
+    BOOST_CHECK(std::isinf(distances[2]));
+    // (2, 2) spans the whole front in both objectives
+    BOOST_CHECK_CLOSE(distances[3], 2.0, 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(pareto_crowded_order_test) {
+    // Front 0 repeats one point, so its middle copy has a distance of 0,
+    // and front 1 has two ends
+    std::vector<Objectives> points{{2, 3}, {3, 2}, {1, 1}, {1, 1}, {1, 1}};
+    auto order = ParetoArchive::crowded_order(points);
+    BOOST_CHECK((order == std::vector<unsigned>{2, 4, 3, 0, 1}));
+
+    BOOST_CHECK((ParetoArchive::crowded_order({{2, 3}, {1, 3}, {4, 4}, {2, 2}, {3, 2}, {3, 1}})
+                 == std::vector<unsigned>{1, 5, 3, 0, 4, 2}));
+}
+
+BOOST_AUTO_TEST_CASE(pareto_update_test) {
+    ParetoArchive archive;
+    BOOST_CHECK_EQUAL(archive.update(make_population({{1.0, 0.9}, {0.8, 1.1},
+                                                      {1.1, 1.1}})), 2);
+    BOOST_REQUIRE_EQUAL(archive.size(), 2);
+    // By critical path
+    BOOST_CHECK_EQUAL(archive.front()[0].K, 3);
+    BOOST_CHECK_CLOSE(archive.points()[0].first, 0.8, 1e-9);
+    BOOST_CHECK_CLOSE(archive.points()[1].second, 0.9, 1e-9);
+
+    // Replaces both, and the same point again is not added
+    BOOST_CHECK_EQUAL(archive.update(make_population({{0.8, 0.9}, {0.8, 0.9}})), 1);
+    BOOST_REQUIRE_EQUAL(archive.size(), 1);
+    BOOST_CHECK_EQUAL(archive.front()[0].K, 2);
+
+    // Failed ones do not count
+    Population failed = make_population({{0.1, 0.1}});
+    failed.set_failed(0, Architecture::Benchmark::Status::ERROR);
+    BOOST_CHECK_EQUAL(archive.update(failed), 0);
+
+    // A new trade-off goes in order
+    BOOST_CHECK_EQUAL(archive.update(make_population({{0.9, 0.5}})), 1);
+    BOOST_REQUIRE_EQUAL(archive.size(), 2);
+    BOOST_CHECK_CLOSE(archive.points()[1].first, 0.9, 1e-9);
+}
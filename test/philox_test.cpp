@@ -0,0 +1,93 @@
+#define BOOST_TEST_MODULE PhiloxTest
+#include <boost/test/unit_test.hpp>
+
+#include "Philox.h"
+#include "Random.h"
+
+#include <set>
+#include <vector>
+
+namespace {
+
+void check_block(Philox::Counter counter, Philox::Key key,
+                 Philox::Counter expected) {
+    Philox::Counter result = Philox::block(counter, key);
+    for (unsigned i = 0; i < 4; i++) {
+        BOOST_CHECK_EQUAL(result[i], expected[i]);
+    }
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(philox_known_answer_test) {
+    // The known answers of Random123 for philox4x32_10
+    check_block({{0, 0, 0, 0}}, {{0, 0}},
+                {{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}});
+    check_block({{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}},
+                {{0xffffffff, 0xffffffff}},
+                {{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}});
+    check_block({{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}},
+                {{0xa4093822, 0x299f31d0}},
+                {{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}});
+}
+
+BOOST_AUTO_TEST_CASE(philox_output_test) {
+    // Two outputs per block, low word first
+    Philox rng;
+    BOOST_CHECK_EQUAL(rng(), 0xe169c58d6627e8d5ULL);
+    BOOST_CHECK_EQUAL(rng(), 0x9b00dbd8bc57ac4cULL);
+}
+
+BOOST_AUTO_TEST_CASE(philox_discard_test) {
+    for (unsigned skip : {0u, 1u, 2u, 3u, 7u, 64u}) {
+        for (unsigned before : {0u, 1u}) {
+            Philox a{5, 9}, b{5, 9};
+            for (unsigned i = 0; i < before; i++) {
+                a();
+                b();
+            }
+            for (unsigned i = 0; i < skip; i++) {
+                a();
+            }
+            b.discard(skip);
+            BOOST_CHECK_EQUAL(a(), b());
+            BOOST_CHECK_EQUAL(a(), b());
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(philox_stream_test) {
+    std::set<Philox::result_type> seen;
+    for (std::uint64_t stream = 0; stream < 16; stream++) {
+        Philox rng{1, stream};
+        for (unsigned i = 0; i < 16; i++) {
+            seen.insert(rng());
+        }
+    }
+    BOOST_CHECK_EQUAL(seen.size(), 16 * 16);
+
+    Philox a{1, 3}, b{2, 3};
+    BOOST_CHECK_NE(a(), b());
+}
+
+BOOST_AUTO_TEST_CASE(random_seed_test) {
+    Random::seed(1234);
+    BOOST_CHECK_EQUAL(Random::seed(), 1234);
+
+    std::vector<Philox::result_type> first;
+    Philox job = Random::stream(Random::Domain::JOB, 7);
+    Philox& thread = Random::thread_stream();
+    first.push_back(job());
+    first.push_back(thread());
+
+    // The same seed gives the same streams, thread streams restart
+    Random::seed(1234);
+    job = Random::stream(Random::Domain::JOB, 7);
+    BOOST_CHECK_EQUAL(job(), first[0]);
+    BOOST_CHECK_EQUAL(Random::thread_stream()(), first[1]);
+
+    // Different domains with the same id differ
+    Philox individual = Random::stream(Random::Domain::INDIVIDUAL, 7);
+    job = Random::stream(Random::Domain::JOB, 7);
+    BOOST_CHECK_NE(individual(), job());
+}
@@ -0,0 +1,157 @@
+#define BOOST_TEST_MODULE PopulationTest
+#include <boost/test/unit_test.hpp>
+
+#include "Population.h"
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+std::vector<Architecture::Benchmark> make_benchmarks() {
+    return {
+        Architecture::Benchmark{"/benchmarks/ch_intrinsics.blif"},
+        Architecture::Benchmark{"/benchmarks/diffeq1.blif"}
+    };
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(population_add_test) {
+    Population p{make_benchmarks()};
+    BOOST_CHECK(p.empty());
+    BOOST_CHECK_EQUAL(p.num_benchmarks(), 2);
+    BOOST_CHECK_EQUAL(p.benchmark_name(1), "/benchmarks/diffeq1.blif");
+
+    BOOST_CHECK_EQUAL(p.add(6, 10, 84), 0);
+    BOOST_CHECK_EQUAL(p.add(4, 8, 40), 1);
+    BOOST_CHECK_EQUAL(p.size(), 2);
+    BOOST_CHECK_EQUAL(p.K(1), 4);
+    BOOST_CHECK_EQUAL(p.N(1), 8);
+    BOOST_CHECK_EQUAL(p.W(1), 40);
+    BOOST_CHECK(!p.already_run(0));
+    BOOST_CHECK(!p.non_failed(0));
+}
+
+BOOST_AUTO_TEST_CASE(population_store_test) {
+    Population p{make_benchmarks()};
+    p.add(6, 10, 84);
+
+    Architecture arch = p.to_architecture(0);
+    BOOST_CHECK_EQUAL(arch.K, 6);
+    BOOST_REQUIRE_EQUAL(arch.bench.size(), 2);
+    BOOST_CHECK_EQUAL(arch.bench[0].get_filename(), "/benchmarks/ch_intrinsics.blif");
+
+    for (Architecture::Benchmark& b : arch.bench) {
+        b.area = 1000;
+        b.crit_path = 2.5;
+        b.is_populated = true;
+        b.status = Architecture::Benchmark::Status::SUCCESS;
+        b.stats.route_iterations = 7;
+    }
+    p.store(0, arch);
+    BOOST_CHECK(p.already_run(0));
+    BOOST_CHECK(p.non_failed(0));
+    BOOST_CHECK_EQUAL(p.result(0, 1).area, 1000);
+    BOOST_CHECK_EQUAL(p.total_stats(0).route_iterations, 14);
+    BOOST_CHECK_EQUAL(p.to_architecture(0).bench[1].crit_path, 2.5);
+}
+
+BOOST_AUTO_TEST_CASE(population_reorder_test) {
+    Population p{make_benchmarks()};
+    for (unsigned i = 0; i < 5; i++) {
+        p.add(2 + i, 10, 80);
+        p.result(i, 0).area = 100 * i;
+        p.result(i, 0).crit_path = 1;
+        p.result(i, 1).area = 1;
+        p.result(i, 1).crit_path = 1;
+    }
+    p.set_failed(1, Architecture::Benchmark::Status::UNROUTABLE);
+    p.set_failed(3, Architecture::Benchmark::Status::ERROR);
+
+    p.remove_failed();
+    BOOST_REQUIRE_EQUAL(p.size(), 3);
+    BOOST_CHECK_EQUAL(p.K(0), 2);
+    BOOST_CHECK_EQUAL(p.K(1), 4);
+    BOOST_CHECK_EQUAL(p.K(2), 6);
+    BOOST_CHECK_EQUAL(p.result(2, 0).area, 400);
+
+    Population q;
+    q.gather(p, {2, 0});
+    BOOST_REQUIRE_EQUAL(q.size(), 2);
+    BOOST_CHECK_EQUAL(q.num_benchmarks(), 2);
+    BOOST_CHECK_EQUAL(q.K(0), 6);
+    BOOST_CHECK_EQUAL(q.result(0, 0).area, 400);
+
+    q.add(p, 1);
+    BOOST_CHECK_EQUAL(q.K(2), 4);
+
+    Population before = p;
+    p.swap(q);
+    BOOST_CHECK(q == before);
+    BOOST_CHECK(p != before);
+    BOOST_CHECK_EQUAL(p.size(), 3);
+
+    p.truncate(1);
+    BOOST_CHECK_EQUAL(p.size(), 1);
+    p.clear();
+    BOOST_CHECK(p.empty());
+    BOOST_CHECK_EQUAL(p.num_benchmarks(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(population_strategy_test) {
+    Population p{make_benchmarks()};
+    p.add(6, 10, 84);
+    BOOST_CHECK_EQUAL(p.strategy(0).mutation_amount, 0);
+    BOOST_CHECK_LT(p.strategy(0).parent_fitness, 0);
+
+    Architecture::Genome::Values genome{{4, 8, 40}};
+    p.add(genome, Population::Strategy{0.2f, 0.5f});
+    p.strategy(1).parent_fitness = 0.9;
+
+    // Moves with its individual
+    Population q;
+    q.gather(p, {1, 0});
+    BOOST_CHECK_EQUAL(q.strategy(0).mutation_amount, 0.2f);
+    BOOST_CHECK_EQUAL(q.strategy(0).mutation_occurrence_rate, 0.5f);
+    BOOST_CHECK_EQUAL(q.strategy(0).parent_fitness, 0.9);
+
+    q.truncate(1);
+    p.swap(q);
+    BOOST_CHECK_EQUAL(p.size(), 1);
+    BOOST_CHECK_EQUAL(p.strategy(0).mutation_amount, 0.2f);
+}
+
+BOOST_AUTO_TEST_CASE(population_reference_test) {
+    Population p{make_benchmarks()};
+    p.add(6, 10, 84);
+    for (unsigned b = 0; b < p.num_benchmarks(); b++) {
+        p.result(0, b).area = 200;
+        p.result(0, b).crit_path = 2;
+        p.result(0, b).is_populated = true;
+    }
+
+    // Nothing to compare against yet
+    BOOST_CHECK(!p.reference());
+    BOOST_CHECK_EQUAL(p.fitness(0), 1);
+
+    auto reference = std::make_shared<Architecture>(make_benchmarks());
+    reference->bench[0].area = 100;
+    reference->bench[0].crit_path = 4;
+    reference->bench[1].area = 400;
+    reference->bench[1].crit_path = 1;
+    p.set_reference(reference);
+    // Until all of its benchmarks have results
+    BOOST_CHECK_EQUAL(p.fitness(0), 1);
+    reference->bench[0].is_populated = true;
+    reference->bench[1].is_populated = true;
+    BOOST_CHECK_CLOSE(p.vs_ref_area(0), (2 + 0.5) / 2, 1e-9);
+    BOOST_CHECK_CLOSE(p.vs_ref_crit_path(0), (0.5 + 2) / 2, 1e-9);
+
+    // Kept by copies, not taken from the source of add
+    Population q{p};
+    BOOST_CHECK(q.reference() == reference);
+    Population r{make_benchmarks()};
+    r.add(p, 0);
+    BOOST_CHECK(!r.reference());
+}
@@ -0,0 +1,87 @@
+#define BOOST_TEST_MODULE ReclaimerTest
+#include <boost/test/unit_test.hpp>
+
+#include "Reclaimer.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+bool exists(const std::string& path) {
+    struct stat st;
+    return lstat(path.c_str(), &st) == 0;
+}
+
+/* Creates a small tree like the ones ABC and VPR leave behind */
+std::string make_tree() {
+    char buf[] = "/tmp/reclaimer_testXXXXXX";
+    std::string root{mkdtemp(buf)};
+    mkdir((root + "/bench").c_str(), 0700);
+    mkdir((root + "/bench/empty").c_str(), 0700);
+    std::ofstream(root + "/arch.xml") << "<architecture/>";
+    std::ofstream(root + "/bench/bench.abc.blif") << ".model top";
+    // Links are removed, not followed
+    symlink("/tmp", (root + "/bench/link").c_str());
+    return root;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(reclaimer_remove_tree_test) {
+    std::string root = make_tree();
+    BOOST_CHECK(Reclaimer::remove_tree(root));
+    BOOST_CHECK(!exists(root));
+    BOOST_CHECK(exists("/tmp"));
+
+    // Nothing to remove
+    BOOST_CHECK(Reclaimer::remove_tree(root));
+}
+
+BOOST_AUTO_TEST_CASE(reclaimer_queue_test) {
+    std::vector<std::string> dirs;
+    for (unsigned i = 0; i < 10; i++) {
+        dirs.push_back(make_tree());
+    }
+
+    Reclaimer reclaimer;
+    for (const std::string& dir : dirs) {
+        reclaimer.reclaim(dir);
+    }
+    reclaimer.wait();
+
+    for (const std::string& dir : dirs) {
+        BOOST_CHECK(!exists(dir));
+    }
+    BOOST_CHECK_EQUAL(reclaimer.failures(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(reclaimer_retry_test) {
+    // A directory that cannot be removed (parent is read-only) is retried and
+    // then given up on
+    std::string root = make_tree();
+    chmod((root + "/bench").c_str(), 0500);
+    if (Reclaimer::remove_tree(root + "/bench")) {
+        // Running as root, permissions don't stop us
+        Reclaimer::remove_tree(root);
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        Reclaimer reclaimer{3, std::chrono::milliseconds{20}};
+        reclaimer.reclaim(root + "/bench");
+        reclaimer.wait();
+        BOOST_CHECK_EQUAL(reclaimer.failures(), 1);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    BOOST_CHECK(elapsed >= std::chrono::milliseconds{40});
+
+    chmod((root + "/bench").c_str(), 0700);
+    BOOST_CHECK(Reclaimer::remove_tree(root));
+}
@@ -0,0 +1,70 @@
+#define BOOST_TEST_MODULE RouteMonitorTest
+#include <boost/test/unit_test.hpp>
+
+#include "RouteMonitor.h"
+
+#include <cstdio>
+#include <string>
+
+namespace {
+
+const char* HEADER[] = {
+    "Confirming router algorithm: TIMING_DRIVEN.\n",
+    "--------- ---------- ----------- ---------------------\n",
+    "Iteration       Time   Crit Path     Overused RR Nodes\n",
+    "--------- ---------- ----------- ---------------------\n",
+};
+
+std::string row(unsigned iter, double overused) {
+    char buf[128];
+    std::sprintf(buf, "%9u %6.2f sec %8.5f ns   %3.2e (%3.4f %%)\n",
+                 iter, 0.5, 4.51737, overused, 1.0);
+    return buf;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(routemonitor_converging_test) {
+    RouteMonitor monitor{RouteMonitor::Rule{true, 5, 3, 0.1, 50}};
+    for (const char* line : HEADER) {
+        BOOST_CHECK(monitor.feed(line));
+    }
+
+    double overused = 1000;
+    for (unsigned i = 1; i <= 20; i++) {
+        BOOST_CHECK(monitor.feed(row(i, overused).c_str()));
+        overused /= 2;
+    }
+    BOOST_CHECK(monitor.feed("Successfully routed after 20 routing iterations.\n"));
+    BOOST_CHECK(!monitor.abandoned());
+    BOOST_CHECK_EQUAL(monitor.iterations(), 20);
+    BOOST_CHECK_EQUAL(monitor.saved_time(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(routemonitor_stuck_test) {
+    RouteMonitor monitor{RouteMonitor::Rule{true, 5, 3, 0.1, 50}};
+    for (const char* line : HEADER) {
+        monitor.feed(line);
+    }
+
+    unsigned i = 1;
+    while (monitor.feed(row(i, 500 - i).c_str())) {
+        i++;
+        BOOST_REQUIRE_LE(i, 50);
+    }
+    BOOST_CHECK(monitor.abandoned());
+    BOOST_CHECK_EQUAL(monitor.iterations(), 5);
+    // 45 more iterations of 0.5 seconds
+    BOOST_CHECK_CLOSE(monitor.saved_time(), 22.5, 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(routemonitor_disabled_test) {
+    RouteMonitor monitor;
+    for (const char* line : HEADER) {
+        monitor.feed(line);
+    }
+    for (unsigned i = 1; i <= 50; i++) {
+        BOOST_CHECK(monitor.feed(row(i, 500).c_str()));
+    }
+    BOOST_CHECK_EQUAL(monitor.iterations(), 50);
+}
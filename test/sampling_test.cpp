@@ -0,0 +1,103 @@
+#define BOOST_TEST_MODULE SamplingTest
+#include <boost/test/unit_test.hpp>
+
+#include "Genome.h"
+#include "Random.h"
+#include "Sampling.h"
+
+#include <set>
+#include <stdexcept>
+
+namespace {
+
+using Test = GenomeDescriptor<Gene<2, 25>, Gene<1, 50>, Gene<2, 250, 2>>;
+
+const Sampling::Method METHODS[] = {
+    Sampling::Method::RANDOM,
+    Sampling::Method::HALTON,
+    Sampling::Method::SOBOL,
+    Sampling::Method::LATIN_HYPERCUBE
+};
+
+}
+
+BOOST_AUTO_TEST_CASE(parse_method_test) {
+    for (Sampling::Method method : METHODS) {
+        BOOST_CHECK(Sampling::parse_method(Sampling::method_name(method)) == method);
+    }
+    BOOST_CHECK_THROW(Sampling::parse_method("grid"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(unit_cube_test) {
+    for (Sampling::Method method : METHODS) {
+        Philox rng{1, 0};
+        auto points = Sampling::unit_points(method, 100, 3, rng);
+        BOOST_REQUIRE_EQUAL(points.size(), 100);
+        for (const auto& point : points) {
+            BOOST_REQUIRE_EQUAL(point.size(), 3);
+            for (double u : point) {
+                BOOST_CHECK(u >= 0 && u < 1);
+            }
+        }
+    }
+
+    Philox rng{1, 0};
+    BOOST_CHECK_THROW(Sampling::unit_points(Sampling::Method::SOBOL, 4,
+                                            Sampling::MAX_DIMENSIONS + 1, rng),
+                      std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(stratification_test) {
+    // With a power of two points, every dimension has one point in each of
+    // the count equal strata
+    const unsigned count = 64;
+    for (Sampling::Method method : {Sampling::Method::SOBOL,
+                                    Sampling::Method::LATIN_HYPERCUBE}) {
+        Philox rng{7, 0};
+        auto points = Sampling::unit_points(method, count, 3, rng);
+        for (unsigned d = 0; d < 3; d++) {
+            std::set<unsigned> strata;
+            for (const auto& point : points) {
+                strata.insert(static_cast<unsigned>(point[d] * count));
+            }
+            BOOST_CHECK_EQUAL(strata.size(), count);
+        }
+    }
+
+    // Halton in base 2 does the same in its first dimension
+    Philox rng{7, 0};
+    auto points = Sampling::unit_points(Sampling::Method::HALTON, count, 1, rng);
+    std::set<unsigned> strata;
+    for (const auto& point : points) {
+        strata.insert(static_cast<unsigned>(point[0] * count));
+    }
+    BOOST_CHECK_EQUAL(strata.size(), count);
+}
+
+BOOST_AUTO_TEST_CASE(reproducible_test) {
+    for (Sampling::Method method : METHODS) {
+        Philox a{3, 9};
+        Philox b{3, 9};
+        Philox c{4, 9};
+        auto first = Sampling::unit_points(method, 16, 3, a);
+        BOOST_CHECK(first == Sampling::unit_points(method, 16, 3, b));
+        BOOST_CHECK(first != Sampling::unit_points(method, 16, 3, c));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(from_unit_test) {
+    BOOST_CHECK_EQUAL((Gene<2, 250, 2>::from_unit(0)), 2);
+    BOOST_CHECK_EQUAL((Gene<2, 250, 2>::from_unit(0.999999)), 250);
+    BOOST_CHECK_EQUAL((Gene<2, 250, 2>::from_unit(0.5)), 126);
+
+    Philox rng{5, 0};
+    std::set<std::uint64_t> distinct;
+    for (const auto& point : Sampling::unit_points(Sampling::Method::SOBOL, 64,
+                                                   Test::size, rng)) {
+        Test::Values genome = Test::from_unit(point);
+        BOOST_CHECK(Test::valid(genome));
+        BOOST_CHECK_EQUAL(genome[2] % 2, 0);
+        distinct.insert(Test::key(genome));
+    }
+    BOOST_CHECK_EQUAL(distinct.size(), 64);
+}
@@ -0,0 +1,90 @@
+#define BOOST_TEST_MODULE SelectionTest
+#include <boost/test/unit_test.hpp>
+
+#include "Selection.h"
+
+#include <set>
+#include <vector>
+
+namespace {
+
+Population make_population(unsigned size, unsigned distinct) {
+    Population population;
+    for (unsigned i = 0; i < size; i++) {
+        population.add(2 + i % distinct, 10, 80);
+    }
+    return population;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(selection_alias_table_test) {
+    Philox gen{42};
+    Selection::AliasTable table;
+    table.build({1, 0, 3});
+    BOOST_CHECK_EQUAL(table.size(), 3);
+
+    std::vector<unsigned> hits(3, 0);
+    const unsigned draws = 40000;
+    for (unsigned i = 0; i < draws; i++) {
+        hits[table.sample(gen)]++;
+    }
+    BOOST_CHECK_EQUAL(hits[1], 0);
+    BOOST_CHECK_CLOSE(static_cast<double>(hits[0]) / draws, 0.25, 5);
+    BOOST_CHECK_CLOSE(static_cast<double>(hits[2]) / draws, 0.75, 5);
+}
+
+BOOST_AUTO_TEST_CASE(selection_distinct_test) {
+    Philox gen{42};
+    for (Selection::Scheme scheme : {Selection::Scheme::ROULETTE,
+                                     Selection::Scheme::SUS,
+                                     Selection::Scheme::TOURNAMENT}) {
+        Selection selection{scheme, 3};
+        Population population = make_population(50, 50);
+        std::vector<unsigned> picked = selection.select(population, 10, gen);
+        BOOST_CHECK_EQUAL(picked.size(), 10);
+
+        std::set<unsigned> keys;
+        for (unsigned i : picked) {
+            BOOST_CHECK_LT(i, population.size());
+            keys.insert(population.K(i));
+        }
+        BOOST_CHECK_EQUAL(keys.size(), picked.size());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(selection_few_survivors_test) {
+    Philox gen{42};
+    Selection selection;
+    // 100 survivors, but only 3 different architectures
+    Population population = make_population(100, 3);
+    BOOST_CHECK_EQUAL(selection.select(population, 10, gen).size(), 3);
+
+    // One survivor
+    population.truncate(1);
+    BOOST_CHECK_EQUAL(selection.select(population, 5, gen).size(), 1);
+
+    population.clear();
+    BOOST_CHECK(selection.select(population, 5, gen).empty());
+}
+
+BOOST_AUTO_TEST_CASE(selection_rank_bias_test) {
+    Philox gen{42};
+    Selection selection{Selection::Scheme::SUS};
+    Population population = make_population(20, 20);
+
+    // Best first, so the first half should be picked more often
+    unsigned front = 0, back = 0;
+    for (unsigned i = 0; i < 1000; i++) {
+        for (unsigned index : selection.select(population, 4, gen)) {
+            (index < 10 ? front : back)++;
+        }
+    }
+    BOOST_CHECK_GT(front, back);
+}
+
+BOOST_AUTO_TEST_CASE(selection_parse_scheme_test) {
+    BOOST_CHECK(Selection::parse_scheme("sus") == Selection::Scheme::SUS);
+    BOOST_CHECK(Selection::parse_scheme("tournament") == Selection::Scheme::TOURNAMENT);
+    BOOST_CHECK_THROW(Selection::parse_scheme("elitist"), std::invalid_argument);
+}
@@ -0,0 +1,31 @@
+#define BOOST_TEST_MODULE SubprocessTest
+#include <boost/test/unit_test.hpp>
+
+#include "Subprocess.h"
+
+#include <sys/wait.h>
+#include <cstring>
+
+BOOST_AUTO_TEST_CASE(subprocess_output_test) {
+    Subprocess p{"echo hello; exit 3"};
+    char line[16];
+    BOOST_REQUIRE(p.output() != nullptr);
+    BOOST_REQUIRE(fgets(line, sizeof(line), p.output()) != nullptr);
+    BOOST_CHECK_EQUAL(std::strcmp(line, "hello\n"), 0);
+
+    int status = p.wait();
+    BOOST_CHECK(WIFEXITED(status));
+    BOOST_CHECK_EQUAL(WEXITSTATUS(status), 3);
+}
+
+BOOST_AUTO_TEST_CASE(subprocess_kill_test) {
+    // The shell and the sleep it starts must both go away
+    Subprocess p{"echo started; sleep 30; echo done"};
+    char line[16];
+    BOOST_REQUIRE(fgets(line, sizeof(line), p.output()) != nullptr);
+    p.kill();
+    BOOST_CHECK(fgets(line, sizeof(line), p.output()) == nullptr);
+
+    int status = p.wait();
+    BOOST_CHECK(WIFSIGNALED(status));
+}
@@ -0,0 +1,78 @@
+#define BOOST_TEST_MODULE SurrogateTest
+#include <boost/test/unit_test.hpp>
+
+#include "Surrogate.h"
+
+#include <cmath>
+
+namespace {
+
+using Values = Architecture::Genome::Values;
+
+/* Smooth in every gene, best at K = 6, N = 10, W = 80 */
+double bowl(const Values& genome) {
+    const double k = genome[0] - 6.0;
+    const double n = genome[1] - 10.0;
+    const double w = genome[2] - 80.0;
+    return 1 + k * k / 100 + n * n / 400 + w * w / 10000;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(surrogate_add_test) {
+    Surrogate surrogate;
+    BOOST_CHECK(!surrogate.ready());
+
+    surrogate.add(Values{{6, 10, 80}}, 1.0);
+    surrogate.add(Values{{6, 10, 80}}, 0.9);
+    BOOST_CHECK_EQUAL(surrogate.size(), 1);
+    BOOST_CHECK(surrogate.contains(Values{{6, 10, 80}}));
+    BOOST_CHECK(!surrogate.contains(Values{{6, 10, 82}}));
+
+    // Known ones are certain
+    Surrogate::Prediction p = surrogate.predict(Values{{6, 10, 80}});
+    BOOST_CHECK_EQUAL(p.fitness, 0.9);
+    BOOST_CHECK_EQUAL(p.uncertainty, 0);
+}
+
+BOOST_AUTO_TEST_CASE(surrogate_predict_test) {
+    Surrogate surrogate;
+    std::vector<Values> grid;
+    for (unsigned k = 2; k <= 24; k += 4) {
+        for (unsigned n = 2; n <= 50; n += 8) {
+            for (unsigned w = 20; w <= 240; w += 40) {
+                grid.push_back(Values{{k, n, w}});
+                surrogate.add(grid.back(), bowl(grid.back()));
+            }
+        }
+    }
+    BOOST_CHECK(surrogate.ready());
+
+    std::vector<Values> probes{{{7, 11, 84}}, {{12, 30, 150}}, {{23, 49, 248}},
+                               {{3, 5, 40}}, {{16, 20, 100}}};
+    std::vector<double> predicted, actual;
+    for (const Values& probe : probes) {
+        predicted.push_back(surrogate.predict(probe).fitness);
+        actual.push_back(bowl(probe));
+    }
+    BOOST_CHECK_GT(Surrogate::rank_correlation(predicted, actual), 0.8);
+
+    // Further from what has been run, less certain
+    BOOST_CHECK_LT(surrogate.predict(Values{{6, 10, 62}}).uncertainty,
+                   surrogate.predict(Values{{4, 6, 40}}).uncertainty + 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(surrogate_rank_correlation_test) {
+    BOOST_CHECK_CLOSE(Surrogate::rank_correlation({1, 2, 3, 4}, {10, 20, 30, 40}),
+                      1.0, 1e-9);
+    BOOST_CHECK_CLOSE(Surrogate::rank_correlation({1, 2, 3, 4}, {4, 3, 2, 1}),
+                      -1.0, 1e-9);
+    // Only the order matters
+    BOOST_CHECK_CLOSE(Surrogate::rank_correlation({1, 2, 3}, {1, 100, 1000}),
+                      1.0, 1e-9);
+    // Ties get the average rank
+    BOOST_CHECK_CLOSE(Surrogate::rank_correlation({1, 1, 2}, {1, 2, 3}),
+                      std::sqrt(0.75), 1e-9);
+    BOOST_CHECK(std::isnan(Surrogate::rank_correlation({1, 2}, {1, 2})));
+    BOOST_CHECK(std::isnan(Surrogate::rank_correlation({1, 1, 1}, {1, 2, 3})));
+}
@@ -0,0 +1,96 @@
+#define BOOST_TEST_MODULE TerminationTest
+#include <boost/test/unit_test.hpp>
+
+#include "Termination.h"
+
+#include <memory>
+
+namespace {
+
+using Reason = Termination::Reason;
+
+/* One benchmark, with the reference at area 100 and critical path 1 */
+Population make_population(const std::vector<double>& areas) {
+    std::vector<Architecture::Benchmark> benchmarks(1);
+    auto reference = std::make_shared<Architecture>(benchmarks);
+    reference->bench[0].area = 100;
+    reference->bench[0].crit_path = 1;
+    reference->bench[0].is_populated = true;
+
+    Population population{benchmarks};
+    population.set_reference(reference);
+    for (unsigned i = 0; i < areas.size(); i++) {
+        population.add(2 + i, 10, 80);
+        Population::Result& r = population.result(i, 0);
+        r.area = areas[i];
+        r.crit_path = 1;
+        r.is_populated = true;
+        r.status = Architecture::Benchmark::Status::SUCCESS;
+    }
+    return population;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(termination_stagnation_test) {
+    Termination::Criteria criteria;
+    criteria.stagnation = 2;
+    Termination termination{criteria};
+    BOOST_CHECK(!termination.has_best());
+
+    BOOST_CHECK(termination.update(make_population({100, 80})) == Reason::NONE);
+    BOOST_CHECK(termination.has_best());
+    BOOST_CHECK_EQUAL(termination.best().K, 3);
+    BOOST_CHECK_CLOSE(termination.best_fitness(), 0.9, 1e-6);
+
+    // Improves, then stays
+    BOOST_CHECK(termination.update(make_population({60})) == Reason::NONE);
+    BOOST_CHECK(termination.update(make_population({70})) == Reason::NONE);
+    BOOST_CHECK(termination.update(make_population({60})) == Reason::STAGNATION);
+    BOOST_CHECK(termination.reason() == Reason::STAGNATION);
+    // The best is kept even though the population lost it
+    BOOST_CHECK_EQUAL(termination.best().K, 2);
+    BOOST_CHECK_EQUAL(termination.best().bench[0].area, 60);
+}
+
+BOOST_AUTO_TEST_CASE(termination_diversity_test) {
+    Termination::Criteria criteria;
+    criteria.min_diversity = 0.5;
+    Termination termination{criteria};
+
+    Population population = make_population({100, 90, 80, 70});
+    BOOST_CHECK(termination.update(population) == Reason::NONE);
+
+    // Three copies of the same architecture
+    Population collapsed = make_population({100});
+    for (unsigned i = 0; i < 3; i++) {
+        collapsed.add(collapsed, 0);
+    }
+    BOOST_CHECK(termination.update(collapsed) == Reason::DIVERSITY);
+}
+
+BOOST_AUTO_TEST_CASE(termination_budget_test) {
+    Termination::Criteria criteria;
+    criteria.wall_budget = 3600;
+    Termination termination{criteria};
+
+    // Nothing to go by yet
+    BOOST_REQUIRE(termination.start_evaluation());
+    termination.finished(60, 10);
+    BOOST_CHECK(termination.start_evaluation());
+    termination.finished(60, 10);
+
+    // An evaluation now takes longer than the budget
+    BOOST_REQUIRE(termination.start_evaluation());
+    termination.finished(20000, 10);
+    BOOST_CHECK(!termination.start_evaluation());
+    BOOST_CHECK(termination.update(make_population({100})) == Reason::WALL_BUDGET);
+
+    // Without budgets, everything runs
+    Termination unlimited;
+    BOOST_REQUIRE(unlimited.start_evaluation());
+    unlimited.finished(1e6, 1e6);
+    BOOST_CHECK(unlimited.start_evaluation());
+    BOOST_CHECK(unlimited.update(make_population({100})) == Reason::NONE);
+    BOOST_CHECK(std::string{Termination::reason_name(Reason::CPU_BUDGET)} == "CPU budget");
+}
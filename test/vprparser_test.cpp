@@ -0,0 +1,72 @@
+#define BOOST_TEST_MODULE VprParserTest
+#include <boost/test/unit_test.hpp>
+
+#include "VprParser.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+const std::string LOG =
+    "VPR FPGA Placement and Routing.\n"
+    "Packing took 1.5 seconds.\n"
+    "Placement took 7.25 seconds.\n"
+    "Successfully routed after 14 routing iterations.\n"
+    "\tTotal wirelength: 14213, average net length: 7.36042\n"
+    "Warning 2: Net '" + std::string(1000, 'n') + "' has a long name.\n"
+    "\tTotal logic block area (Warning, need to add pitch of routing to "
+    "blocks with height > 3): 3.33301e+06\n"
+    "\tTotal used logic block area: 2.53293e+06\n"
+    "Routing area (in minimum width transistor areas)...\n"
+    "\tTotal routing area: 1.85467e+06, per logic tile: 8242.98\n"
+    "Final critical path: 5.03441 ns, f_max: 198.633 MHz\n"
+    "Routing took 3.75 seconds.\n"
+    "The entire flow of VPR took 12.5 seconds.\n";
+
+}
+
+BOOST_AUTO_TEST_CASE(vprparser_parse_test) {
+    FILE* in = fmemopen(const_cast<char*>(LOG.data()), LOG.size(), "r");
+    VprParser parser;
+    BOOST_CHECK(parser.parse(in));
+    std::fclose(in);
+
+    BOOST_CHECK(parser.complete());
+    BOOST_CHECK_CLOSE(parser.area(), 2.53293e+06 + 1.85467e+06, 1e-9);
+    BOOST_CHECK_CLOSE(parser.crit_path(), 5.03441, 1e-9);
+
+    BOOST_CHECK_EQUAL(parser.pack_time(), 1.5);
+    BOOST_CHECK_EQUAL(parser.place_time(), 7.25);
+    BOOST_CHECK_EQUAL(parser.route_time(), 3.75);
+    BOOST_CHECK_EQUAL(parser.route_iterations(), 14);
+    BOOST_CHECK_EQUAL(parser.wirelength(), 14213);
+}
+
+BOOST_AUTO_TEST_CASE(vprparser_incomplete_test) {
+    VprParser parser;
+    BOOST_CHECK(parser.feed("\tTotal used logic block area: 2.5e+06\n"));
+    BOOST_CHECK(parser.feed("Routing failed.\n"));
+    BOOST_CHECK(!parser.complete());
+    BOOST_CHECK_EQUAL(parser.route_time(), 0);
+
+    BOOST_CHECK(!parser.parse(nullptr));
+}
+
+BOOST_AUTO_TEST_CASE(vprparser_file_test) {
+    char path[] = "/tmp/vprparser_testXXXXXX";
+    int fd = mkstemp(path);
+    BOOST_REQUIRE(fd != -1);
+    BOOST_REQUIRE_EQUAL(write(fd, LOG.data(), LOG.size()),
+                        static_cast<ssize_t>(LOG.size()));
+    close(fd);
+
+    VprParser parser;
+    BOOST_CHECK(parser.parse_file(path));
+    BOOST_CHECK_CLOSE(parser.crit_path(), 5.03441, 1e-9);
+    unlink(path);
+
+    BOOST_CHECK(!VprParser{}.parse_file(path));
+}
@@ -0,0 +1,124 @@
+#define BOOST_TEST_MODULE WarmStartTest
+#include <boost/test/unit_test.hpp>
+
+#include "Batch.h"
+#include "EvaluationArchive.h"
+#include "WarmStart.h"
+
+#include <unistd.h>
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Values = Architecture::Genome::Values;
+
+std::string temp_path() {
+    char buf[] = "/tmp/warmstart_testXXXXXX";
+    int fd = mkstemp(buf);
+    close(fd);
+    unlink(buf);
+    return std::string{buf};
+}
+
+std::vector<Architecture::Benchmark> benchmarks() {
+    return {Architecture::Benchmark{"bench/a.blif"}, Architecture::Benchmark{"bench/b.blif"}};
+}
+
+const char* const RESULTS =
+    "index,K,N,W,benchmark,status,area,crit_path,route_iters\n"
+    "0,6,10,80,/old/a.blif,success,1000,4,12\n"
+    "0,6,10,80,/old/b.blif,success,3000,8,14\n"
+    // Better on both, and run again with worse results later
+    "1,4,8,60,/old/a.blif,success,800,3,10\n"
+    "1,4,8,60,/old/b.blif,success,2000,6,10\n"
+    "2,4,8,60,/old/a.blif,success,5000,9,10\n"
+    // Failed on one benchmark
+    "3,5,6,40,/old/a.blif,success,500,2,10\n"
+    "3,5,6,40,/old/b.blif,unroutable,-1,-1,50\n"
+    // Missing a benchmark, and one this run does not have
+    "4,8,2,100,/old/a.blif,success,100,1,10\n"
+    "4,8,2,100,/old/c.blif,success,100,1,10\n"
+    // Only left out
+    "5,9,9,90,/old/a.blif,out_of_budget,-1,-1,0\n"
+    "5,9,9,90,/old/b.blif,out_of_budget,-1,-1,0\n";
+
+}
+
+BOOST_AUTO_TEST_CASE(warmstart_csv_test) {
+    std::istringstream is{RESULTS};
+    Population results = WarmStart::read_csv(is, benchmarks());
+    BOOST_REQUIRE_EQUAL(results.size(), 3);
+    BOOST_CHECK_EQUAL(results.num_benchmarks(), 2);
+    for (unsigned i = 0; i < results.size(); i++) {
+        BOOST_CHECK(results.already_run(i));
+    }
+
+    // The first results of each benchmark
+    BOOST_CHECK(results.genome(1) == (Values{{4, 8, 60}}));
+    BOOST_CHECK_EQUAL(results.result(1, 0).area, 800);
+    BOOST_CHECK_EQUAL(results.result(1, 1).stats.route_iterations, 10);
+    BOOST_CHECK(!results.non_failed(2));
+
+    std::vector<unsigned> best = WarmStart::best(results, 5);
+    BOOST_REQUIRE_EQUAL(best.size(), 2);
+    BOOST_CHECK_EQUAL(best[0], 1);
+    BOOST_CHECK_EQUAL(best[1], 0);
+    BOOST_CHECK_EQUAL(WarmStart::best(results, 1).size(), 1);
+
+    std::istringstream no_status{"K,N,W,benchmark,area,crit_path\n"};
+    BOOST_CHECK_THROW(WarmStart::read_csv(no_status, benchmarks()), std::invalid_argument);
+    std::istringstream bad{"K,N,W,benchmark,status,area,crit_path\n6,10,80,a.blif,fine,1,1\n"};
+    BOOST_CHECK_THROW(WarmStart::read_csv(bad, benchmarks()), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(warmstart_archive_test) {
+    std::string path = temp_path();
+    {
+        EvaluationArchive archive{path};
+        BOOST_REQUIRE(archive.ok());
+        Architecture arch{benchmarks()};
+        arch.set_genome(Values{{6, 10, 80}});
+        for (Architecture::Benchmark& b : arch.bench) {
+            b.area = 1000;
+            b.crit_path = 4;
+            b.is_populated = true;
+            b.status = Architecture::Benchmark::Status::SUCCESS;
+        }
+        archive.append(3, arch);
+        archive.flush();
+    }
+
+    Population results = WarmStart::load(path, benchmarks());
+    BOOST_REQUIRE_EQUAL(results.size(), 1);
+    BOOST_CHECK(results.genome(0) == (Values{{6, 10, 80}}));
+    BOOST_CHECK_EQUAL(results.result(0, 1).crit_path, 4);
+    BOOST_CHECK(results.non_failed(0));
+    unlink(path.c_str());
+
+    BOOST_CHECK_THROW(WarmStart::load(path, benchmarks()), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(warmstart_precision_test) {
+    Architecture arch{benchmarks()};
+    arch.set_genome(Values{{6, 10, 80}});
+    for (Architecture::Benchmark& b : arch.bench) {
+        b.area = 12345678.91;
+        b.crit_path = 1.0 / 3;
+        b.is_populated = true;
+        b.status = Architecture::Benchmark::Status::SUCCESS;
+    }
+
+    // Every digit survives a batch CSV
+    std::ostringstream os;
+    Batch::write_csv_header(os);
+    Batch::write_csv(os, 0, arch);
+    std::istringstream is{os.str()};
+    Population results = WarmStart::read_csv(is, benchmarks());
+    BOOST_REQUIRE_EQUAL(results.size(), 1);
+    BOOST_CHECK_EQUAL(results.result(0, 0).area, 12345678.91);
+    BOOST_CHECK_EQUAL(results.result(0, 1).crit_path, 1.0 / 3);
+}
@@ -0,0 +1,64 @@
+#define BOOST_TEST_MODULE WorkspaceTest
+#include <boost/test/unit_test.hpp>
+
+#include "Workspace.h"
+
+#include <sys/stat.h>
+#include <unistd.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+bool exists(const std::string& path) {
+    struct stat st;
+    return stat(path.c_str(), &st) == 0;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(workspace_stage_test) {
+    std::string root;
+    std::string job1, job2;
+    {
+        std::ofstream("workspace_test_template.xml") << "<architecture/>";
+        std::ofstream("workspace_test_bench.blif") << ".model top";
+
+        Workspace ws{"/tmp", "workspace_test_template.xml"};
+        BOOST_REQUIRE(ws.ok());
+        root = ws.root();
+        BOOST_CHECK_EQUAL(root.find("/tmp/"), 0);
+
+        std::vector<std::string> inputs{"workspace_test_bench.blif"};
+        BOOST_REQUIRE(ws.stage(inputs));
+        BOOST_CHECK_EQUAL(ws.arch_template().find(root), 0);
+        BOOST_CHECK_EQUAL(ws.input(inputs[0]).find(root), 0);
+        BOOST_CHECK(exists(ws.input(inputs[0])));
+        // Paths that were not staged are left alone
+        BOOST_CHECK_EQUAL(ws.input("other.blif"), "other.blif");
+
+        // Same name, different directories
+        job1 = ws.make_job_dir("6_10_84");
+        job2 = ws.make_job_dir("6_10_84");
+        BOOST_CHECK(!job1.empty());
+        BOOST_CHECK_NE(job1, job2);
+        BOOST_CHECK(exists(job1));
+        BOOST_CHECK(exists(job2));
+
+        unlink("workspace_test_template.xml");
+        unlink("workspace_test_bench.blif");
+    }
+    BOOST_CHECK(!exists(job1));
+    BOOST_CHECK(!exists(root));
+}
+
+BOOST_AUTO_TEST_CASE(workspace_missing_input_test) {
+    Workspace ws{"/tmp", "does_not_exist.xml"};
+    BOOST_REQUIRE(ws.ok());
+    BOOST_CHECK(!ws.stage({}));
+
+    Workspace bad{"/does/not/exist", "does_not_exist.xml"};
+    BOOST_CHECK(!bad.ok());
+    BOOST_CHECK(bad.make_job_dir("x").empty());
+}
@@ -0,0 +1,82 @@
+#include "ArchiveReader.h"
+
+#include "cxxopts.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[]) {
+    ArchiveReader::Filter filter;
+    std::string output;
+    bool count_only = false;
+    bool show_help = false;
+
+    std::string usage = " <archive>";
+    cxxopts::Options options{argv[0], usage};
+    options.add_options()
+        ("from-generation", "First generation to export",
+         cxxopts::value(filter.min_generation))
+        ("to-generation", "Last generation to export",
+         cxxopts::value(filter.max_generation))
+        ("lut-size", "Only architectures with this LUT size",
+         cxxopts::value(filter.K))
+        ("cluster-size", "Only architectures with this cluster size",
+         cxxopts::value(filter.N))
+        ("channel-width", "Only architectures with this channel width",
+         cxxopts::value(filter.W))
+        ("b,benchmark", "Only this benchmark (file name)",
+         cxxopts::value(filter.benchmark))
+        ("success", "Only successful runs",
+         cxxopts::value(filter.success_only))
+        ("o,output", "Write the CSV to this file instead of stdout",
+         cxxopts::value(output))
+        ("count", "Only print the number of matching evaluations",
+         cxxopts::value(count_only))
+        ("h,help", "Show this help",
+         cxxopts::value(show_help));
+    options.parse(argc, argv);
+
+    if (show_help) {
+        std::cout << options.help() << std::endl;
+        return 0;
+    }
+
+    if (argc != 2) {
+        std::cerr << "Need exactly one archive" << std::endl;
+        std::cerr << options.help() << std::endl;
+        return 1;
+    }
+
+    ArchiveReader reader{argv[1]};
+    if (!reader.ok()) {
+        std::cerr << "Cannot read archive " << argv[1] << std::endl;
+        return 1;
+    }
+
+    if (count_only) {
+        std::cout << reader.for_each(filter, [](const ArchiveReader::Evaluation&,
+                                                const std::string&) {})
+            << std::endl;
+        return 0;
+    }
+
+    std::ofstream file;
+    if (!output.empty()) {
+        file.open(output);
+        if (!file) {
+            std::cerr << "Cannot write to " << output << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& os = output.empty() ? std::cout : file;
+
+    ArchiveReader::write_csv_header(os);
+    reader.for_each(filter, [&os](const ArchiveReader::Evaluation& e,
+                                  const std::string& benchmark) {
+                    ArchiveReader::write_csv(os, e, benchmark);
+                    });
+    os.flush();
+
+    return os ? 0 : 1;
+}